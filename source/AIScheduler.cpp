@@ -0,0 +1,82 @@
+#include "AIScheduler.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+	double NowMicroseconds()
+	{
+		using namespace std::chrono;
+		return duration<double, std::micro>(steady_clock::now().time_since_epoch()).count();
+	}
+
+} // namespace
+
+AIScheduler::AIScheduler()
+	: currentSource(0)
+	, cursor(0)
+	, budgetMicroseconds(1000.0)
+	, thinkLimit(0)
+	, batchSize(64)
+	, runCount(0)
+	, passStartRun(1)
+	, stats{ 0, 0, 0, 0 }
+{ }
+
+size_t AIScheduler::AddSource(std::function<size_t()> count, std::function<void(size_t, size_t)> think)
+{
+	sources.push_back({ std::move(count), std::move(think) });
+	return sources.size() - 1;
+}
+
+void AIScheduler::Run()
+{
+	++runCount;
+	stats.thinksLastRun = 0;
+	stats.microsecondsLastRun = 0;
+	if (sources.empty()) return;
+
+	const double start = NowMicroseconds();
+	bool ranBatch = false;
+
+	while (!ranBatch || (thinkLimit > 0 ? stats.thinksLastRun < thinkLimit : NowMicroseconds() - start < budgetMicroseconds))
+	{
+		Source& source = sources[currentSource];
+		size_t count = source.count();
+
+		if (cursor >= count)
+		{
+			cursor = 0;
+			if (++currentSource == sources.size())
+			{
+				currentSource = 0;
+				FinishPass();
+				break; // nobody thinks twice in one tick
+			}
+			continue;
+		}
+
+		size_t end = std::min(count, cursor + batchSize);
+		if (thinkLimit > 0) end = std::min(end, cursor + (thinkLimit - stats.thinksLastRun));
+		source.think(cursor, end);
+		stats.thinksLastRun += end - cursor;
+		cursor = end;
+		ranBatch = true;
+	}
+
+	stats.microsecondsLastRun = NowMicroseconds() - start;
+
+	stats.pendingThisPass = 0;
+	for (size_t i = currentSource; i < sources.size(); ++i)
+	{
+		size_t count = sources[i].count();
+		size_t done = i == currentSource ? std::min(cursor, count) : 0;
+		stats.pendingThisPass += count - done;
+	}
+}
+
+void AIScheduler::FinishPass()
+{
+	stats.lastPassTicks = runCount - passStartRun + 1;
+	passStartRun = runCount + 1;
+}
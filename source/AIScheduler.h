@@ -0,0 +1,66 @@
+#pragma once
+#ifndef AISCHEDULER_H
+#define AISCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// spreads "think" work (target selection, path refresh, decisions) over ticks under a time budget.
+// agents come from sources that think in index ranges; Run walks them round-robin in batches, picks
+// up where the last tick stopped and stops once the budget is used up. movement keeps integrating
+// every tick from whatever the agent last decided, so a big wave makes decisions older rather than
+// ticks longer. sources whose agents get swap-and-popped may skip or repeat an agent for one pass.
+class AIScheduler {
+public:
+	struct Stats {
+		size_t thinksLastRun;       // agents that thought during the last Run
+		double microsecondsLastRun;
+		size_t pendingThisPass;     // agents not yet reached in the current pass
+		uint64_t lastPassTicks;     // how many Runs the last full pass over every agent took, i.e.
+		                            // how old a decision can get. 1 means everybody thinks every tick
+	};
+
+	AIScheduler();
+
+	// count is read at the start of every batch, think(begin, end) runs the agents in [begin, end)
+	size_t AddSource(std::function<size_t()> count, std::function<void(size_t, size_t)> think);
+
+	void SetBudgetMicroseconds(double microseconds) { budgetMicroseconds = microseconds; }
+	double GetBudgetMicroseconds() const { return budgetMicroseconds; }
+
+	// > 0: every Run thinks exactly this many agents (fewer at the end of a pass) and ignores the time
+	// budget, so how many think per tick doesn't depend on the machine. recordings and replays need
+	// that. SIZE_MAX = everybody every tick, 0 = back to the time budget
+	void SetThinkLimit(size_t agentsPerRun) { thinkLimit = agentsPerRun; }
+	size_t GetThinkLimit() const { return thinkLimit; }
+	void SetBatchSize(size_t agents) { batchSize = agents > 0 ? agents : 1; }
+
+	// one time slice, call once per tick. always runs at least one batch so a tiny budget still makes progress
+	void Run();
+
+	const Stats& GetStats() const { return stats; }
+
+private:
+	struct Source {
+		std::function<size_t()> count;
+		std::function<void(size_t, size_t)> think;
+	};
+
+	void FinishPass();
+
+	std::vector<Source> sources;
+	size_t currentSource;
+	size_t cursor;              // next agent in sources[currentSource]
+
+	double budgetMicroseconds;
+	size_t thinkLimit;
+	size_t batchSize;
+
+	uint64_t runCount;
+	uint64_t passStartRun;
+	Stats stats;
+};
+
+#endif // AISCHEDULER_H
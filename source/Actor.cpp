@@ -1,22 +1,76 @@
 #include "Actor.h"
+#include "GameMode.h"
+#include "RenderCommands.h"
+#include "GameSprites.h"
+
 Actor::Actor()
 	:position({0,0}),
+	previousPosition({0,0}),
 	rotation(0),
 	scale({1, 1}),
 	active(true),
-	actorName("Actor")
+	actorName("Actor"),
+	gameMode(nullptr),
+	typeId(0),
+	denseIndex(0),
+	lodTime(0),
+	batchIndex(0),
+	pendingDestroy(false)
 { }
 
 Actor::~Actor(){}
 
+void Actor::SetActive(bool isActive)
+{
+	if (active == isActive) return;
+
+	active = isActive;
+	if (gameMode) gameMode->QueueActiveChange(this);
+}
+
+Vector2 Actor::GetRenderPosition() const
+{
+	if (!gameMode) return position;
+
+	float alpha = gameMode->GetInterpolationAlpha();
+	return {
+		previousPosition.x + (position.x - previousPosition.x) * alpha,
+		previousPosition.y + (position.y - previousPosition.y) * alpha
+	};
+}
+
+bool Actor::UsesTickLod(const Actor& actor)
+{
+	return actor.gameMode && actor.gameMode->GetTickLod().enabled;
+}
+
+bool Actor::PrepareTick(float deltaTime, float& tickTime)
+{
+	if (!active) return false;
+
+	if (gameMode && gameMode->GetTickLod().enabled)
+	{
+		const TickLod& lod = gameMode->GetTickLod();
+		lodTime += deltaTime;
+		if (!lod.IsDue(handle.index, lod.GetInterval(previousPosition))) return false;
+
+		deltaTime = lodTime;
+		lodTime = 0;
+	}
+
+	tickTime = deltaTime;
+	return true;
+}
+
 void Actor::BeginPlay() {}	
 
-void Actor::Tick(float deltaTime){}
+void Actor::Tick(float /*deltaTime*/){}
 
-void Actor::Draw()
+void Actor::Draw(RenderCommandList& commands)
 {
 	if (active)
 	{
-		DrawRectangle(position.x - 10, position.y - 10, 20, 20, RED);
+		Vector2 drawPos = GetRenderPosition();
+		commands.PushSprite(kSpriteActor, drawPos.x - 10, drawPos.y - 10, 20, 20);
 	}
 }
\ No newline at end of file
@@ -3,8 +3,24 @@
 #define ACTOR_H
 
 #include "raylib.h"
+#include "ActorHandle.h"
+#include "Random.h"
 #include <string>
 
+class GameMode;
+class RenderCommandList;
+template<typename T> class ActorPool;
+
+// a run of actors of one concrete type, what TickAll/DrawAll get
+template<typename T>
+struct ActorSpan {
+	T* const* data;
+	size_t size;
+
+	T* const* begin() const { return data; }
+	T* const* end() const { return data + size; }
+};
+
 class Actor {
 public:
 	Actor();
@@ -14,22 +30,118 @@ public:
 	// great value unreal methods
 	virtual void BeginPlay();   // called when actor enters game
 	virtual void Tick(float deltaTime); // called every frame
-	virtual void Draw();     // called on every frame for rendering
+	virtual void Draw(RenderCommandList& commands);     // called on every frame for rendering, records shapes into the frame's command list
+
+	// batch entry points, GameMode calls T::TickAll / T::DrawAll once per concrete type with its active
+	// actors (TickAll in parallel chunks). the defaults call T::Tick / T::Draw directly, no vtable.
+	// a class can hide them with its own static TickAll(ActorSpan<Self>, float) to do the whole batch at once
+	template<typename T>
+	static void TickAll(ActorSpan<T> actors, float deltaTime)
+	{
+		// without the tick lod every active actor ticks with deltaTime, no PrepareTick call per actor
+		if (actors.size > 0 && !UsesTickLod(*actors.data[0])) {
+			for (T* actor : actors) {
+				if (actor->IsActive()) actor->T::Tick(deltaTime);
+			}
+			return;
+		}
+
+		for (T* actor : actors) {
+			float tickTime;
+			if (actor->PrepareTick(deltaTime, tickTime)) actor->T::Tick(tickTime);
+		}
+	}
+
+	// how many actors of a type one TickAll job gets at least. the default suits cheap ticks, where
+	// splitting a pool into small jobs costs more than ticking it on one thread
+	static constexpr size_t kTickGrainSize = 1024;
+
+	// SpawnActors runs BeginPlay through this once per wave, spread over the job system when
+	// T::kParallelBeginPlay says T's BeginPlay only touches its own actor
+	static constexpr bool kParallelBeginPlay = false;
+
+	template<typename T>
+	static void BeginPlayAll(ActorSpan<T> actors)
+	{
+		for (T* actor : actors) {
+			actor->T::BeginPlay();
+		}
+	}
+
+	template<typename T>
+	static void DrawAll(ActorSpan<T> actors, RenderCommandList& commands)
+	{
+		for (T* actor : actors) {
+			if (actor->IsActive()) actor->T::Draw(commands);
+		}
+	}
+
+	// false when this actor doesn't tick this time (inactive, or skipped by the tick lod),
+	// otherwise tickTime is the dt to tick with (including time banked while skipped)
+	bool PrepareTick(float deltaTime, float& tickTime);
+	// whether actor's game mode runs the tick lod, i.e. PrepareTick can skip actors
+	static bool UsesTickLod(const Actor& actor);
+
+	// decisions (targets, paths) that don't have to be redone every tick. the game mode's AIScheduler
+	// calls it round-robin under a time budget on the game thread before the tick, Tick moves by the result
+	virtual void Think() {}
 
 	//transform (every actor will have a positive/rotation/scale)
 	void SetPosition(Vector2 newPos) { position = newPos; }
 	Vector2 GetPosition() const { return position; }
 
+	// state as of the start of this tick. actors tick concurrently, so a Tick that looks at
+	// *another* actor must read this, never GetPosition() (see GameMode::Update)
+	Vector2 GetPreviousPosition() const { return previousPosition; }
+	void SavePreviousState() { previousPosition = position; }
+
+	// where to draw this frame: between the previous and current tick by the game mode's interpolation alpha
+	Vector2 GetRenderPosition() const;
+
 	// basic properties
-	void SetActive(bool isActive) { active = isActive; }
+	// inactive actors are moved out of the ticked/drawn range at the end of the frame
+	void SetActive(bool isActive);
 	bool IsActive() const { return active; }
 
+	// contact: everything is a circle for overlap tests against the spatial grid.
+	// actors that TakesContactDamage() lose GetContactDamage() per second from everything touching them
+	virtual float GetCollisionRadius() const { return 10.0f; }
+	virtual float GetContactDamage() const { return 0.0f; }
+	virtual bool TakesContactDamage() const { return false; }
+	virtual void TakeDamage(float /*amount*/) {}
+	virtual float GetHealth() const { return 0.0f; }
+
+	// set by GameMode::SpawnActor, actors created by hand have no game mode and an unset handle
+	ActorHandle GetHandle() const { return handle; }
+	size_t GetTypeId() const { return typeId; }
+	GameMode* GetGameMode() const { return gameMode; }
+	const std::string& GetName() const { return actorName; }
+	bool IsPendingDestroy() const { return pendingDestroy; }
+
+	// this actor's own random stream, seeded from the world seed and spawn order when it is spawned.
+	// only this actor draws from it, so BeginPlay/Think/Tick can use it from any thread
+	Rng& GetRandom() { return rng; }
+
 protected:
 	Vector2 position;
+	Vector2 previousPosition;
 	float rotation;
 	Vector2 scale;
 	bool active;
 	std::string actorName;
+	Rng rng;
+
+private:
+	friend class GameMode;
+	template<typename T> friend class ActorPool;
+
+	GameMode* gameMode;
+	ActorHandle handle;
+	size_t typeId;       // which pool owns the memory
+	size_t denseIndex;   // position in GameMode::actors
+	float lodTime;       // dt banked while the tick lod skipped us
+	size_t batchIndex;   // position in the pool's active list
+	bool pendingDestroy;
 };
 
 #endif
\ No newline at end of file
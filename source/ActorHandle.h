@@ -0,0 +1,31 @@
+#pragma once
+#ifndef ACTORHANDLE_H
+#define ACTORHANDLE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// stable reference to a spawned actor: slot index + generation.
+// the slot's generation is bumped when its actor is destroyed, so stale handles resolve to nullptr
+// (GameMode::ResolveActor) instead of pointing at a dead or recycled actor.
+struct ActorHandle {
+	uint32_t index = 0;
+	uint32_t generation = 0; // 0 is never handed out, a default handle is always invalid
+
+	bool IsSet() const { return generation != 0; }
+
+	bool operator==(const ActorHandle& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const ActorHandle& other) const { return !(*this == other); }
+};
+
+// the handles of one SpawnActors wave, in spawn order
+struct ActorHandleRange {
+	const ActorHandle* data;
+	size_t size;
+
+	const ActorHandle* begin() const { return data; }
+	const ActorHandle* end() const { return data + size; }
+	const ActorHandle& operator[](size_t index) const { return data[index]; }
+};
+
+#endif // ACTORHANDLE_H
@@ -0,0 +1,174 @@
+#pragma once
+#ifndef ACTORPOOL_H
+#define ACTORPOOL_H
+
+#include "Actor.h"
+#include "ActorTypes.h"
+#include "LevelArena.h"
+#include "JobSystem.h"
+#include <cstddef>
+#include <new>
+#include <vector>
+
+
+class ActorPoolBase {
+public:
+	virtual ~ActorPoolBase() {}
+
+	// runs the destructor and puts the slot on the free list
+	virtual void Free(Actor* actor) = 0;
+	// forgets every slot without touching them, used together with LevelArena::Reset
+	virtual void Reset() = 0;
+
+	// the pool also keeps its type's active actors together, so ticking and drawing run one concrete
+	// type at a time through T::TickAll / T::DrawAll instead of a virtual call per actor
+	virtual void AddActive(Actor* actor) = 0;
+	virtual void RemoveActive(Actor* actor) = 0;
+	virtual size_t GetActiveCount() const = 0;
+	virtual void TickAll(JobSystem& jobs, float deltaTime) = 0;
+	virtual void DrawAll(RenderCommandList& commands) = 0;
+	// only these (all of this pool's type), what the camera culling found
+	virtual void DrawVisible(RenderCommandList& commands, const std::vector<Actor*>& visible) = 0;
+};
+
+// fixed size slots for one actor class carved out of the level arena in blocks.
+// Allocate/Free are O(1): freed slots go on an intrusive free list and are reused first.
+template<typename T>
+class ActorPool : public ActorPoolBase {
+public:
+	explicit ActorPool(LevelArena& arena, size_t slotsPerBlock = 256)
+		: arena(arena)
+		, slotsPerBlock(slotsPerBlock)
+		, freeList(nullptr)
+		, blockCursor(nullptr)
+		, blockRemaining(0)
+	{ }
+
+	T* Allocate()
+	{
+		Slot* slot = freeList;
+
+		if (slot)
+		{
+			freeList = slot->nextFree;
+		}
+		else
+		{
+			if (blockRemaining == 0)
+			{
+				blockCursor = static_cast<Slot*>(arena.Allocate(sizeof(Slot) * slotsPerBlock, alignof(Slot)));
+				blockRemaining = slotsPerBlock;
+			}
+
+			slot = blockCursor++;
+			--blockRemaining;
+		}
+
+		return new (slot->storage) T();
+	}
+
+	// count fresh slots back to back (one arena allocation when the current block is too small),
+	// constructed and returned in order. valid until the next AllocateRun. freed slots still go
+	// back to the free list, which only Allocate uses
+	ActorSpan<T> AllocateRun(size_t count)
+	{
+		Slot* run;
+		if (blockRemaining >= count)
+		{
+			run = blockCursor;
+			blockCursor += count;
+			blockRemaining -= count;
+		}
+		else
+		{
+			run = static_cast<Slot*>(arena.Allocate(sizeof(Slot) * count, alignof(Slot)));
+		}
+
+		spawned.resize(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			spawned[i] = new (run[i].storage) T();
+		}
+		return ActorSpan<T>{ spawned.data(), count };
+	}
+
+	void ReserveActive(size_t count) { active.reserve(active.size() + count); }
+
+	virtual void Free(Actor* actor) override
+	{
+		T* object = static_cast<T*>(actor);
+		object->~T();
+
+		Slot* slot = reinterpret_cast<Slot*>(object);
+		slot->nextFree = freeList;
+		freeList = slot;
+	}
+
+	virtual void Reset() override
+	{
+		freeList = nullptr;
+		blockCursor = nullptr;
+		blockRemaining = 0;
+		active.clear();
+	}
+
+	virtual void AddActive(Actor* actor) override
+	{
+		T* object = static_cast<T*>(actor);
+		object->batchIndex = active.size();
+		active.push_back(object);
+	}
+
+	virtual void RemoveActive(Actor* actor) override
+	{
+		size_t index = actor->batchIndex;
+		active[index] = active.back();
+		active[index]->batchIndex = index;
+		active.pop_back();
+	}
+
+	virtual size_t GetActiveCount() const override { return active.size(); }
+
+	virtual void TickAll(JobSystem& jobs, float deltaTime) override
+	{
+		// a pool that fits in one job ticks right here, without going through the job system
+		if (active.size() <= T::kTickGrainSize)
+		{
+			T::TickAll(ActorSpan<T>{ active.data(), active.size() }, deltaTime);
+			return;
+		}
+
+		jobs.ParallelFor(0, active.size(), T::kTickGrainSize, [this, deltaTime](size_t begin, size_t end) {
+			T::TickAll(ActorSpan<T>{ active.data() + begin, end - begin }, deltaTime);
+		});
+	}
+
+	virtual void DrawAll(RenderCommandList& commands) override
+	{
+		T::DrawAll(ActorSpan<T>{ active.data(), active.size() }, commands);
+	}
+
+	virtual void DrawVisible(RenderCommandList& commands, const std::vector<Actor*>& visible) override
+	{
+		drawList.clear();
+		for (Actor* actor : visible) drawList.push_back(static_cast<T*>(actor));
+		T::DrawAll(ActorSpan<T>{ drawList.data(), drawList.size() }, commands);
+	}
+
+private:
+	union Slot {
+		Slot* nextFree;
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	LevelArena& arena;
+	size_t slotsPerBlock;
+	Slot* freeList;
+	Slot* blockCursor;
+	size_t blockRemaining;
+	std::vector<T*> active;
+	std::vector<T*> spawned; // last AllocateRun
+	std::vector<T*> drawList; // DrawVisible's
+};
+
+#endif // ACTORPOOL_H
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef ACTORTYPES_H
+#define ACTORTYPES_H
+
+#include <cstddef>
+#include <type_traits>
+
+class Actor;
+class Player;
+class Enemy;
+
+template<typename... Types>
+struct ActorTypeList {
+	static constexpr size_t kCount = sizeof...(Types);
+};
+
+// every actor class SpawnActor can make. a class's type id is its place in this list, fixed at
+// compile time, so GameMode keeps its pools and per-type tick phases in arrays of kActorTypeCount
+// and nothing is looked up or handed out at runtime. a new actor class gets added here
+typedef ActorTypeList<Actor, Player, Enemy> GameActorTypes;
+
+const size_t kActorTypeCount = GameActorTypes::kCount;
+
+template<typename T, typename List>
+struct ActorTypeIndex;
+
+template<typename T>
+struct ActorTypeIndex<T, ActorTypeList<>> {
+	static_assert(!std::is_same<T, T>::value, "spawned actor class is missing from GameActorTypes (ActorTypes.h)");
+	static constexpr size_t value = 0;
+};
+
+template<typename T, typename... Rest>
+struct ActorTypeIndex<T, ActorTypeList<T, Rest...>> {
+	static constexpr size_t value = 0;
+};
+
+template<typename T, typename First, typename... Rest>
+struct ActorTypeIndex<T, ActorTypeList<First, Rest...>> {
+	static constexpr size_t value = 1 + ActorTypeIndex<T, ActorTypeList<Rest...>>::value;
+};
+
+template<typename T>
+constexpr size_t ActorTypeId()
+{
+	return ActorTypeIndex<T, GameActorTypes>::value;
+}
+
+#endif // ACTORTYPES_H
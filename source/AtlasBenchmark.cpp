@@ -0,0 +1,123 @@
+#include "Benchmarks.h"
+#include "GameMode.h"
+#include "Actor.h"
+#include "Player.h"
+#include "Enemy.h"
+#include "BatchRenderer.h"
+#include "TextureAtlas.h"
+#include "GameSprites.h"
+#include "Random.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+	const int kBuilds = 20;
+
+	// count images of 8..96 px a side, same ones every run
+	std::vector<SpriteImage> MakeImages(int count)
+	{
+		Rng rng(23, kRngStreamScenario);
+		std::vector<SpriteImage> images;
+		for (int i = 0; i < count; ++i)
+		{
+			int width = rng.RangeInt(8, 96);
+			int height = rng.RangeInt(8, 96);
+			images.emplace_back(width, height, Color{ static_cast<unsigned char>(i), 128, 200, 255 });
+		}
+		return images;
+	}
+
+	void PackSprites(int count)
+	{
+		std::vector<SpriteImage> images = MakeImages(count);
+		size_t area = 0;
+		for (const SpriteImage& image : images) area += static_cast<size_t>(image.width) * image.height;
+
+		double totalMs = 0;
+		int pages = 0;
+		bool deterministic = true;
+		std::vector<TextureAtlas::Region> first;
+
+		for (int build = 0; build < kBuilds; ++build)
+		{
+			TextureAtlas atlas(1024);
+			for (int i = 0; i < count; ++i) atlas.Add("sprite", images[i]);
+
+			double start = Profiler::NowMs();
+			atlas.Build();
+			totalMs += Profiler::NowMs() - start;
+			pages = atlas.GetPageCount();
+
+			for (int i = 0; i < count; ++i)
+			{
+				const TextureAtlas::Region& region = atlas.GetRegion(i);
+				if (build == 0) first.push_back(region);
+				else deterministic = deterministic && std::memcmp(&region, &first[i], sizeof(region)) == 0;
+			}
+		}
+
+		std::printf("%6d sprites  %2d pages of 1024  %5.1f%% filled  build %7.3f ms  same layout every build: %s\n",
+			count, pages, 100.0 * area / (static_cast<double>(pages) * 1024 * 1024), totalMs / kBuilds, deterministic ? "yes" : "NO");
+	}
+
+	// what drawing with one texture per sprite would bind: a switch whenever the next command samples
+	// another sprite's texture (solid shapes share raylib's white one)
+	size_t CountPerSpriteBinds(const RenderCommandList& commands)
+	{
+		size_t binds = 0;
+		int64_t current = -2;
+		for (size_t i = 0; i < commands.Size(); ++i)
+		{
+			int64_t texture = commands[i].type == RenderCommand::Sprite ? commands[i].payload : -1;
+			if (texture != current) ++binds;
+			current = texture;
+		}
+		return binds;
+	}
+
+	void DrawScene(int perType)
+	{
+		GameMode gameMode;
+		gameMode.SetWorldSeed(23);
+		gameMode.SpawnActors<Actor>(perType, [](Actor&, size_t) {});
+		gameMode.SpawnActors<Player>(perType, [](Player&, size_t) {});
+		gameMode.SpawnActors<Enemy>(perType, [](Enemy&, size_t) {});
+		gameMode.GetEnemySwarm().SpawnWave(perType, nullptr);
+		gameMode.SetCullingEnabled(false);
+
+		TextureAtlas atlas(256);
+		AddGameSprites(atlas);
+		atlas.Build();
+
+		RenderCommandList commands;
+		BatchRenderer renderer;
+		renderer.SetAtlas(&atlas);
+		gameMode.Draw(commands);
+
+		const int frames = 50;
+		double start = Profiler::NowMs();
+		for (int frame = 0; frame < frames; ++frame) renderer.Submit(commands);
+		double submitMs = (Profiler::NowMs() - start) / frames;
+
+		std::printf("%6d each of Actor/Player/Enemy/swarm enemy: %zu commands, %zu quads\n", perType, commands.Size(), renderer.GetQuadCount());
+		std::printf("        a texture per sprite: %7zu texture binds\n", CountPerSpriteBinds(commands));
+		std::printf("        one atlas page:       %7zu texture binds, %zu rlgl batches, submit %.3f ms\n",
+			renderer.GetTextureBindCount(), renderer.GetBatchCount(), submitMs);
+	}
+
+} // namespace
+
+int RunAtlasBenchmark()
+{
+	std::printf("atlas benchmark: skyline packing of random 8-96 px sprites, %d builds each\n", kBuilds);
+	const int counts[] = { 100, 500, 2000 };
+	for (int count : counts) PackSprites(count);
+
+	std::printf("\ndrawing a frame through the game atlas (null rlgl backend)\n");
+	DrawScene(1000);
+	DrawScene(10000);
+	return 0;
+}
@@ -0,0 +1,44 @@
+#include "Benchmarks.h"
+#include "GameMode.h"
+#include "Player.h"
+#include "BatchRenderer.h"
+
+#include <cstdio>
+
+int RunBatchBenchmark()
+{
+	std::printf("batch renderer: recording swarm commands, expanding them into quads and submitting to the null rlgl backend\n");
+
+	const size_t sizes[] = { 1000, 10000, 100000, 1000000 };
+	for (size_t count : sizes)
+	{
+		GameMode gameMode;
+		gameMode.SpawnActor<Player>({ 400, 300 });
+		gameMode.GetEnemySwarm().Reserve(count);
+		for (size_t i = 0; i < count; ++i) gameMode.SpawnEnemy();
+
+		RenderCommandList commands;
+		BatchRenderer renderer;
+		const int frames = static_cast<int>(count >= 100000 ? 20 : 200);
+
+		double packMs = 0, submitMs = 0;
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			double start = Profiler::NowMs();
+			commands.Clear();
+			gameMode.GetEnemySwarm().Draw(commands);
+			double mid = Profiler::NowMs();
+			renderer.Submit(commands);
+			double end = Profiler::NowMs();
+
+			packMs += mid - start;
+			submitMs += end - mid;
+		}
+
+		size_t quads = renderer.GetQuadCount();
+		std::printf("%8zu enemies  %8zu quads  record %9.0f quads/ms  submit %9.0f quads/ms  %zu rlgl batches\n",
+			count, quads, quads * frames / packMs, quads * frames / submitMs, renderer.GetBatchCount());
+	}
+
+	return 0;
+}
@@ -0,0 +1,135 @@
+#include "BatchRenderer.h"
+#include "rlgl.h"
+#include <cmath>
+
+BatchRenderer::BatchRenderer(size_t quadCapacity)
+	: page(0)
+	, whiteUv{ 0, 0 }
+	, quadCount(0)
+	, batchCount(0)
+	, textureBinds(0)
+{
+	vertices.reserve(quadCapacity * 4);
+}
+
+void BatchRenderer::PushCircle(float centerX, float centerY, float radius, Color color, int segments)
+{
+	// two fan triangles per quad: center, a, b, c
+	const float step = 2.0f * PI / segments;
+	vertices.reserve(vertices.size() + (segments + 1) / 2 * 4);
+
+	float angle = 0;
+	for (int i = 0; i < segments; i += 2)
+	{
+		size_t at = vertices.size();
+		vertices.resize(at + 4);
+		BatchVertex* v = &vertices[at];
+
+		const float tu = whiteUv.x, tv = whiteUv.y;
+		v[0] = { centerX, centerY, tu, tv, color.r, color.g, color.b, color.a };
+		v[1] = { centerX + std::sin(angle) * radius, centerY + std::cos(angle) * radius, tu, tv, color.r, color.g, color.b, color.a };
+		v[2] = { centerX + std::sin(angle + step) * radius, centerY + std::cos(angle + step) * radius, tu, tv, color.r, color.g, color.b, color.a };
+		v[3] = { centerX + std::sin(angle + 2 * step) * radius, centerY + std::cos(angle + 2 * step) * radius, tu, tv, color.r, color.g, color.b, color.a };
+
+		angle += 2 * step;
+	}
+}
+
+void BatchRenderer::Submit(const RenderCommandList& commands)
+{
+	quadCount = 0;
+	batchCount = 0;
+	textureBinds = 0;
+	page = 0;
+	whiteUv = atlas && atlas->IsBuilt() ? atlas->GetWhiteUv() : Vector2{ 0, 0 };
+
+	const size_t screenSpaceStart = commands.GetScreenSpaceStart();
+
+	BeginMode2D(commands.GetCamera());
+	Expand(commands, 0, screenSpaceStart);
+	EndMode2D();
+
+	Expand(commands, screenSpaceStart, commands.Size());
+}
+
+void BatchRenderer::Expand(const RenderCommandList& commands, size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; ++i)
+	{
+		const RenderCommand& command = commands[i];
+		switch (command.type)
+		{
+		case RenderCommand::Rect:
+			UsePage(0);
+			PushQuad(command.x, command.y, command.width, command.height, whiteUv.x, whiteUv.y, whiteUv.x, whiteUv.y, command.color);
+			break;
+		case RenderCommand::Circle:
+			UsePage(0);
+			PushCircle(command.x, command.y, command.width, command.color, command.segments);
+			break;
+		case RenderCommand::Sprite:
+			if (atlas && atlas->IsBuilt())
+			{
+				const TextureAtlas::Region& region = atlas->GetRegion(command.payload);
+				UsePage(region.page);
+				PushQuad(command.x, command.y, command.width, command.height, region.u0, region.v0, region.u1, region.v1, command.color);
+			}
+			else
+			{
+				PushQuad(command.x, command.y, command.width, command.height, 0, 0, 0, 0, command.color);
+			}
+			break;
+		case RenderCommand::Text:
+			Flush();
+			DrawText(commands.GetText(command), static_cast<int>(command.x), static_cast<int>(command.y), command.fontSize, command.color);
+			break;
+		}
+	}
+
+	Flush();
+}
+
+void BatchRenderer::UsePage(int newPage)
+{
+	if (newPage == page) return;
+
+	Flush();
+	page = newPage;
+}
+
+void BatchRenderer::Flush()
+{
+	const size_t count = vertices.size() / 4;
+	if (count == 0) return;
+
+	// without an uploaded atlas the default texture is plain white, so vertex color is all that shows
+	unsigned int texture = atlas ? atlas->GetTextureId(page) : 0;
+	rlSetTexture(texture != 0 ? texture : rlGetTextureIdDefault());
+	++textureBinds;
+
+	for (size_t first = 0; first < count; first += kQuadsPerBatch)
+	{
+		size_t batch = count - first < kQuadsPerBatch ? count - first : kQuadsPerBatch;
+
+		// flush whatever is queued once up front instead of checking per shape
+		rlCheckRenderBatchLimit(static_cast<int>(batch * 4));
+
+		rlBegin(RL_QUADS);
+		rlNormal3f(0.0f, 0.0f, 1.0f);
+
+		const BatchVertex* v = &vertices[first * 4];
+		for (size_t i = 0; i < batch * 4; ++i)
+		{
+			rlColor4ub(v[i].r, v[i].g, v[i].b, v[i].a);
+			rlTexCoord2f(v[i].u, v[i].v);
+			rlVertex2f(v[i].x, v[i].y);
+		}
+
+		rlEnd();
+		++batchCount;
+	}
+
+	rlSetTexture(0);
+	quadCount += count;
+	vertices.clear();
+}
@@ -0,0 +1,71 @@
+#pragma once
+#ifndef BATCHRENDERER_H
+#define BATCHRENDERER_H
+
+#include "raylib.h"
+#include "RenderBackend.h"
+#include <cstddef>
+#include <vector>
+
+// one vertex of the frame's quad stream, 20 bytes
+struct BatchVertex {
+	float x;
+	float y;
+	float u;
+	float v;
+	unsigned char r, g, b, a;
+};
+
+// draws a RenderCommandList through rlgl: every shape is expanded into one pre-sized vertex buffer,
+// then handed to rlgl in as few RL_QUADS batches as rlgl's internal buffer allows (no per-shape
+// DrawRectangle overhead, no early flushes). sprites sample the atlas and solid shapes its white
+// texel, so with a one page atlas the whole frame is one texture and nothing splits the batch.
+// circles go into the same stream as fans of degenerate quads, the same trick raylib uses itself
+// when quads are supported. text is drawn by raylib in between, flushing what came before it.
+// needs the GL context, so main thread only
+class BatchRenderer : public RenderBackend {
+public:
+	explicit BatchRenderer(size_t quadCapacity = 16384);
+
+	// without an atlas (or before its Upload) sprites come out as solid quads of their tint
+	virtual void Submit(const RenderCommandList& commands) override;
+
+	size_t GetQuadCount() const { return quadCount; }     // quads sent by the last Submit
+	size_t GetBatchCount() const { return batchCount; }   // rlBegin/rlEnd pairs used by the last Submit
+	size_t GetTextureBindCount() const { return textureBinds; } // rlSetTexture calls of the last Submit
+
+	// rlgl's default batch holds 8192 quads, stay under it so a chunk never overflows
+	static const size_t kQuadsPerBatch = 4096;
+
+private:
+	void PushQuad(float x, float y, float width, float height, float u0, float v0, float u1, float v1, Color color)
+	{
+		size_t at = vertices.size();
+		vertices.resize(at + 4);
+		BatchVertex* v = &vertices[at];
+
+		// same winding as raylib's DrawRectanglePro
+		v[0] = { x, y, u0, v0, color.r, color.g, color.b, color.a };
+		v[1] = { x, y + height, u0, v1, color.r, color.g, color.b, color.a };
+		v[2] = { x + width, y + height, u1, v1, color.r, color.g, color.b, color.a };
+		v[3] = { x + width, y, u1, v0, color.r, color.g, color.b, color.a };
+	}
+
+	void PushCircle(float centerX, float centerY, float radius, Color color, int segments);
+
+	// flushes when the page changes
+	void UsePage(int page);
+
+	// commands [begin, end), text flushes the quads before it
+	void Expand(const RenderCommandList& commands, size_t begin, size_t end);
+	void Flush();
+
+	std::vector<BatchVertex> vertices;
+	int page;           // atlas page the queued vertices sample
+	Vector2 whiteUv;    // solid shapes sample here
+	size_t quadCount;
+	size_t batchCount;
+	size_t textureBinds;
+};
+
+#endif // BATCHRENDERER_H
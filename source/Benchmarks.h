@@ -0,0 +1,19 @@
+#pragma once
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+// microbenchmarks bundled with the headless runner, run with "Headless --bench <name>"
+
+int RunSeekBenchmark();            // seek kernel paths vs its scalar one, Enemy::Tick alone for reference
+int RunThreadScalingBenchmark();   // GameMode::Update from 1 to N job system threads
+int RunSpawnBenchmark();           // make_unique per spawn vs the pooled SpawnActor vs SpawnActors
+int RunBatchBenchmark();           // BatchRenderer quads packed/submitted per millisecond
+int RunDispatchBenchmark();        // virtual Tick/Draw per actor vs T::TickAll/T::DrawAll per type
+int RunTimerBenchmark();           // cooldowns polled every tick vs the TimerManager timing wheel
+int RunCullBenchmark();            // GameMode::Draw of a big map with and without camera culling
+int RunAtlasBenchmark();           // texture atlas packing time/fill and texture binds with vs without it
+int RunRasterBenchmark();          // SoftwareRenderer ms per 1080p frame from 1 to N threads
+int RunHudBenchmark();             // HUD labels formatted and laid out every frame vs retained in HudText
+int RunPipelineBenchmark();        // frames with simulation and submission in sequence vs on the RenderPipeline
+
+#endif // BENCHMARKS_H
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef COMPONENTTYPES_H
+#define COMPONENTTYPES_H
+
+#include <cstddef>
+#include <type_traits>
+
+struct Location;
+struct PlayerControl;
+struct Seek;
+struct Health;
+struct ContactDamage;
+struct ContactVictim;
+struct Sprite;
+struct HealthBar;
+struct Slow;
+struct ActorLink;
+
+template<typename... Types>
+struct ComponentTypeList {
+	static constexpr size_t kCount = sizeof...(Types);
+};
+
+// every component an EntityWorld can hold (EcsComponents.h). a component's id is its place in this
+// list, fixed at compile time like the actor type ids in ActorTypes.h, so masks and column lookups are
+// constants and nothing is registered at runtime. a new component struct gets added here
+typedef ComponentTypeList<Location, PlayerControl, Seek, Health, ContactDamage, ContactVictim, Sprite, HealthBar, Slow, ActorLink> GameComponentTypes;
+
+const size_t kComponentTypeCount = GameComponentTypes::kCount;
+
+template<typename T, typename List>
+struct ComponentTypeIndex;
+
+template<typename T>
+struct ComponentTypeIndex<T, ComponentTypeList<>> {
+	static_assert(!std::is_same<T, T>::value, "component is missing from GameComponentTypes (ComponentTypes.h)");
+	static constexpr size_t value = 0;
+};
+
+template<typename T, typename... Rest>
+struct ComponentTypeIndex<T, ComponentTypeList<T, Rest...>> {
+	static constexpr size_t value = 0;
+};
+
+template<typename T, typename First, typename... Rest>
+struct ComponentTypeIndex<T, ComponentTypeList<First, Rest...>> {
+	static constexpr size_t value = 1 + ComponentTypeIndex<T, ComponentTypeList<Rest...>>::value;
+};
+
+#endif // COMPONENTTYPES_H
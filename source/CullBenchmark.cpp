@@ -0,0 +1,92 @@
+#include "Benchmarks.h"
+#include "GameMode.h"
+#include "Enemy.h"
+#include "EcsSystems.h"
+#include "Random.h"
+#include "BatchRenderer.h"
+
+#include <cstdio>
+
+namespace {
+
+	// a map 10x10 screens big, the camera sees one screen of it at zoom 1
+	const float kMapWidth = 8000.0f;
+	const float kMapHeight = 6000.0f;
+	const int kSwarmEnemies = 50000;
+	const int kActorEnemies = 5000;
+	const int kEntityEnemies = 10000;
+	const int kFrames = 100;
+
+	// recording plus submitting to the null rlgl backend, what the frame pays for drawing
+	double TimeDraw(GameMode& gameMode, RenderCommandList& commands, BatchRenderer& renderer, bool culling)
+	{
+		gameMode.SetCullingEnabled(culling);
+		gameMode.Draw(commands); // warm up, grows the lists
+		renderer.Submit(commands);
+
+		double start = Profiler::NowMs();
+		for (int f = 0; f < kFrames; ++f)
+		{
+			gameMode.Draw(commands);
+			renderer.Submit(commands);
+		}
+		return (Profiler::NowMs() - start) / kFrames;
+	}
+
+} // namespace
+
+int RunCullBenchmark()
+{
+	std::printf("cull benchmark: %d swarm enemies, %d Enemy actors, %d ECS enemies over %.0fx%.0f, %d frames of Draw\n",
+		kSwarmEnemies, kActorEnemies, kEntityEnemies, kMapWidth, kMapHeight, kFrames);
+
+	GameMode gameMode;
+	gameMode.SetThreadCount(1);
+	gameMode.GetProfiler().SetEnabled(false);
+	gameMode.SetWorldSeed(21);
+	gameMode.SetCameraBounds({ 0, 0, kMapWidth, kMapHeight });
+	gameMode.SetCameraTarget({ kMapWidth * 0.5f, kMapHeight * 0.5f });
+
+	// nobody has a target, so nothing moves and both runs draw the same frame
+	Rng rng = gameMode.CreateRng(kRngStreamScenario);
+	auto randomLocation = [&rng]() { return Vector2{ rng.Range(0, kMapWidth), rng.Range(0, kMapHeight) }; };
+
+	for (int i = 0; i < kSwarmEnemies; ++i)
+	{
+		gameMode.GetEnemySwarm().Spawn(randomLocation());
+	}
+
+	ActorHandleRange actors = gameMode.SpawnActors<Enemy>(kActorEnemies, [](Enemy&, size_t) {});
+	for (size_t i = 0; i < actors.size; ++i)
+	{
+		gameMode.ResolveActor(actors.data[i])->SetPosition(randomLocation());
+	}
+
+	for (int i = 0; i < kEntityEnemies; ++i)
+	{
+		SpawnEnemyEntity(gameMode.GetWorld(), randomLocation(), ActorHandle());
+	}
+
+	// one tick puts the actors' new positions into the grid
+	gameMode.Update(gameMode.GetFixedDeltaTime());
+
+	RenderCommandList commands;
+	BatchRenderer renderer;
+	const float zooms[] = { 1.0f, 0.5f, 0.25f };
+	for (float zoom : zooms)
+	{
+		gameMode.SetCameraZoom(zoom);
+
+		double allMs = TimeDraw(gameMode, commands, renderer, false);
+		double culledMs = TimeDraw(gameMode, commands, renderer, true);
+		const GameMode::CullStats& stats = gameMode.GetCullStats();
+
+		Rectangle view = gameMode.GetViewRect();
+		std::printf("\nzoom %.2f (%.0fx%.0f in view): %zu / %zu visible (actors %zu, swarm %zu, entities %zu)\n",
+			zoom, view.width, view.height, stats.GetVisible(), stats.GetTotal(), stats.visibleActors, stats.visibleSwarm, stats.visibleEntities);
+		std::printf("  draw everything: %8.3f ms/frame\n", allMs);
+		std::printf("  culled:          %8.3f ms/frame (%.1fx)\n", culledMs, allMs / culledMs);
+	}
+
+	return 0;
+}
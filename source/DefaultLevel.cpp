@@ -0,0 +1,47 @@
+#include "DefaultLevel.h"
+#include "GameMode.h"
+#include "Player.h"
+#include "Enemy.h"
+#include "EcsSystems.h"
+
+Player* BuildLevel(GameMode& gameMode, const LevelDescription& level)
+{
+	// spawn player
+	Player* player = gameMode.SpawnActor<Player>({ 400, 300 });
+
+	// a few walls, enemies path around them on the flow field towards the player
+	if (level.walls)
+	{
+		gameMode.GetFlowField().SetBlockedRect({ 200, 100, 20, 200 });
+		gameMode.GetFlowField().SetBlockedRect({ 580, 300, 20, 200 });
+		gameMode.GetFlowField().SetBlockedRect({ 300, 460, 200, 20 });
+	}
+	gameMode.SetPathTarget(player);
+	gameMode.GetAIScheduler().SetBudgetMicroseconds(level.aiBudgetMicroseconds);
+	if (level.lodNear > 0) gameMode.SetTickLod(player, level.lodNear, level.lodFar);
+	gameMode.SetCameraFollow(player);
+
+	// spawn the enemies, all going for the player
+	switch (level.enemyKind)
+	{
+	case kLevelActorEnemies:
+		gameMode.SpawnActors<Enemy>(level.enemyCount, [player](Enemy& enemy, size_t) { enemy.SetTarget(player); });
+		break;
+	case kLevelEntityEnemies:
+	{
+		Rng rng = gameMode.CreateRng(kRngStreamScenario);
+		for (uint32_t i = 0; i < level.enemyCount; ++i)
+		{
+			Vector2 location = { static_cast<float>(rng.RangeInt(50, 750)), static_cast<float>(rng.RangeInt(50, 550)) };
+			SpawnEnemyEntity(gameMode.GetWorld(), location, player->GetHandle());
+		}
+		break;
+	}
+	default:
+		gameMode.GetEnemySwarm().Reserve(level.enemyCount);
+		gameMode.GetEnemySwarm().SpawnWave(level.enemyCount, player);
+		break;
+	}
+
+	return player;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#ifndef DEFAULTLEVEL_H
+#define DEFAULTLEVEL_H
+
+#include <cstdint>
+
+class GameMode;
+class Player;
+
+// what the enemies of a level are made of
+enum LevelEnemyKind : uint8_t {
+	kLevelSwarmEnemies,  // EnemySwarm
+	kLevelActorEnemies,  // Enemy actors
+	kLevelEntityEnemies, // entities in the EntityWorld
+};
+
+// everything a level is built from besides the world seed. the defaults are the level the game plays,
+// the headless runner changes them from its options. recordings keep it, so a replay builds the level
+// the run was recorded on
+struct LevelDescription {
+	uint32_t enemyCount = 5;
+	LevelEnemyKind enemyKind = kLevelSwarmEnemies;
+	bool walls = true;
+	float lodNear = 400.0f;            // 0 = no tick lod, else every 2nd tick past lodNear, every 8th past lodFar
+	float lodFar = 800.0f;
+	double aiBudgetMicroseconds = 1000.0;
+};
+
+// player, walls and enemies going for the player as described. the windowed game and headless
+// replays both build levels through this, so a recording made in one plays back the same in the other.
+// set the world seed first, the enemies' spawn points come from it
+Player* BuildLevel(GameMode& gameMode, const LevelDescription& level);
+
+// the level the game plays: walls, a few swarm enemies
+inline Player* BuildDefaultLevel(GameMode& gameMode) { return BuildLevel(gameMode, LevelDescription()); }
+
+#endif // DEFAULTLEVEL_H
@@ -0,0 +1,89 @@
+#include "Benchmarks.h"
+#include "GameMode.h"
+#include "Player.h"
+#include "Enemy.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+	const int kActorsPerType = 20000;
+	const int kFrames = 100;
+
+	// enemies' separation queries dwarf the dispatch itself, so run once with and once without them
+	void RunScene(bool withEnemies)
+	{
+		std::printf("\n%d each of %s spawned interleaved, 1 thread, %d frames\n",
+			kActorsPerType, withEnemies ? "Actor/Player/Enemy" : "Actor/Player", kFrames);
+
+		GameMode gameMode;
+		gameMode.SetThreadCount(1);
+		gameMode.GetProfiler().SetEnabled(false);
+		gameMode.ReserveActors(kActorsPerType * 3);
+
+		// spawn order is what the old loop walked: Actor, Player, Enemy, Actor, ...
+		std::vector<Actor*> spawnOrder;
+		spawnOrder.reserve(kActorsPerType * 3);
+		for (int i = 0; i < kActorsPerType; ++i)
+		{
+			spawnOrder.push_back(gameMode.SpawnActor<Actor>({ static_cast<float>(i % 800), 100 }));
+			spawnOrder.push_back(gameMode.SpawnActor<Player>({ 400, 300 }));
+			if (withEnemies) spawnOrder.push_back(gameMode.SpawnActor<Enemy>({ 0, 0 })); // no target, only separation
+		}
+
+		const float deltaTime = 1.0f / 60.0f;
+		RenderCommandList commands;
+
+		// the two paths take turns every frame so neither gets a warmer cache or clock
+		double virtualTick = 0, virtualDraw = 0, batchedTick = 0, batchedDraw = 0;
+		for (int frame = 0; frame < kFrames; ++frame)
+		{
+			// before: one virtual Tick/Draw per actor in spawn order
+			double start = Profiler::NowMs();
+			for (Actor* actor : spawnOrder)
+			{
+				float tickTime;
+				if (actor->PrepareTick(deltaTime, tickTime)) actor->Tick(tickTime);
+			}
+			double mid = Profiler::NowMs();
+
+			commands.Clear();
+			for (Actor* actor : spawnOrder)
+			{
+				if (actor->IsActive()) actor->Draw(commands);
+			}
+			double end = Profiler::NowMs();
+
+			virtualTick += mid - start;
+			virtualDraw += end - mid;
+
+			// after: T::TickAll / T::DrawAll per type
+			start = Profiler::NowMs();
+			gameMode.TickActors(deltaTime);
+			mid = Profiler::NowMs();
+
+			commands.Clear();
+			gameMode.DrawActors(commands);
+			end = Profiler::NowMs();
+
+			batchedTick += mid - start;
+			batchedDraw += end - mid;
+		}
+
+		std::printf("%-28s %10s %10s\n", "", "tick ms", "draw ms");
+		std::printf("%-28s %10.3f %10.3f\n", "virtual, spawn order", virtualTick / kFrames, virtualDraw / kFrames);
+		std::printf("%-28s %10.3f %10.3f\n", "TickAll/DrawAll per type", batchedTick / kFrames, batchedDraw / kFrames);
+		std::printf("speedup: tick %.2fx, draw %.2fx\n", virtualTick / batchedTick, virtualDraw / batchedDraw);
+	}
+
+} // namespace
+
+int RunDispatchBenchmark()
+{
+	std::printf("dispatch benchmark: virtual Tick/Draw per actor in spawn order vs T::TickAll/T::DrawAll per type\n");
+
+	RunScene(false);
+	RunScene(true);
+	return 0;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#ifndef ECSCOMPONENTS_H
+#define ECSCOMPONENTS_H
+
+#include "raylib.h"
+#include "ActorHandle.h"
+#include "EntityWorld.h"
+#include "TextureAtlas.h"
+#include <cstdint>
+
+class Actor;
+
+// plain data components for the EntityWorld. an entity only pays for the ones it has,
+// so new per-entity data (status effects, projectiles) is a new struct here (and in GameComponentTypes),
+// not a new Actor field
+
+struct Location {
+	Vector2 position;
+	Vector2 previousPosition; // start of tick, what other entities read and Draw interpolates from
+};
+
+// arrow keys (GameMode::GetInput), same as Player::Tick
+struct PlayerControl {
+	float speed;
+};
+
+// walks towards an actor (or an entity with a Location when no actor is set), along the flow field
+// when the actor is the game mode's path target (same as Enemy)
+struct Seek {
+	ActorHandle target;
+	Entity targetEntity;
+	float speed;
+	float speedScale; // status effects write this, 1 = normal
+	float separation; // pushed away from other Seek entities closer than this, like Enemy (two radii)
+};
+
+struct Health {
+	float current;
+	float max;
+};
+
+// damage per second dealt to every ContactVictim (or contact-damage-taking actor) it overlaps
+struct ContactDamage {
+	float radius;
+	float damagePerSecond;
+};
+
+struct ContactVictim {
+	float radius;
+};
+
+// an atlas region (GameSprites.h) centered on the location
+struct Sprite {
+	SpriteId id;
+	float size;  // side length
+	Color tint;
+};
+
+// bar above the sprite, fill is Health::current / Health::max
+struct HealthBar {
+	float width;
+	float height;
+	float offsetY;
+	Color fillColor;
+};
+
+// status effect: speedScale = factor until it runs out
+struct Slow {
+	float factor;
+	float remaining;
+};
+
+// adapter for actors spawned through GameMode::SpawnActor: every actor gets an entity with one of
+// these, so queries can see legacy actors (contact damage against the Player actor uses it)
+struct ActorLink {
+	Actor* actor;
+};
+
+#endif // ECSCOMPONENTS_H
@@ -0,0 +1,263 @@
+#include "EcsSystems.h"
+#include "GameMode.h"
+#include "Actor.h"
+#include "RenderCommands.h"
+#include "GameSprites.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+	void SnapshotTransforms(EntityWorld& world, JobSystem& jobs)
+	{
+		world.ParallelForEach<Location>(jobs, [](Entity, Location& location) {
+			location.previousPosition = location.position;
+		});
+	}
+
+	// a Slow sets the speed scale while it lasts and takes itself off when it runs out
+	void StatusEffectSystem(EntityWorld& world, float deltaTime)
+	{
+		world.ForEach<Seek>([](Entity, Seek& seek) { seek.speedScale = 1.0f; });
+
+		world.ForEach<Seek, Slow>([&](Entity entity, Seek& seek, Slow& slow) {
+			seek.speedScale *= slow.factor;
+			slow.remaining -= deltaTime;
+			if (slow.remaining <= 0) world.RemoveDeferred<Slow>(entity);
+		});
+	}
+
+	// Player::Tick
+	void PlayerControlSystem(EntityWorld& world, const FlowField& flowField, Rectangle bounds, const InputState& input, float deltaTime)
+	{
+		world.ForEach<Location, PlayerControl>([&](Entity, Location& location, PlayerControl& control) {
+			Vector2& position = location.position;
+			if (input.IsDown(kInputRight)) position.x += control.speed * deltaTime;
+			if (input.IsDown(kInputLeft)) position.x -= control.speed * deltaTime;
+			if (input.IsDown(kInputDown)) position.y += control.speed * deltaTime;
+			if (input.IsDown(kInputUp)) position.y -= control.speed * deltaTime;
+
+			// keep player inside the level and out of walls
+			if (position.x < bounds.x) position.x = bounds.x;
+			if (position.x > bounds.x + bounds.width) position.x = bounds.x + bounds.width;
+			if (position.y < bounds.y) position.y = bounds.y;
+			if (position.y > bounds.y + bounds.height) position.y = bounds.y + bounds.height;
+
+			position = flowField.Slide(location.previousPosition, position);
+		});
+	}
+
+	// start-of-tick positions of everything that seeks, rebuilt every tick (Clear keeps the buckets)
+	void SyncSeekGrid(EntityWorld& world, SpatialGrid& grid)
+	{
+		grid.Clear();
+		world.ForEach<Location, Seek>([&](Entity entity, Location& location, Seek&) {
+			grid.Insert(entity.index, location.previousPosition);
+		});
+	}
+
+	// Enemy::Think + Enemy::Tick, every chunk on its own job. targets and neighbours are only read
+	// through their start-of-tick position (the grid holds those too), nobody writes that during the system
+	void EnemySeekSystem(EntityWorld& world, const SpatialGrid& grid, GameMode& gameMode, float deltaTime)
+	{
+		const FlowField& flowField = gameMode.GetFlowField();
+		const ActorHandle pathTarget = gameMode.GetPathTarget();
+
+		world.ParallelForEach<Location, Seek, Health>(gameMode.GetJobSystem(), [&](Entity entity, Location& location, Seek& seek, Health& health) {
+			// dead enemies leave at the end of the systems
+			if (health.current <= 0)
+			{
+				world.DestroyDeferred(entity);
+				return;
+			}
+
+			// lost our target, go after whatever the level's path target is
+			Actor* targetActor = gameMode.ResolveActor(seek.target);
+			if (!targetActor && seek.target.IsSet())
+			{
+				seek.target = pathTarget;
+				targetActor = gameMode.ResolveActor(seek.target);
+			}
+
+			bool hasTarget = true;
+			Vector2 targetPos = { 0, 0 };
+			if (targetActor) targetPos = targetActor->GetPreviousPosition();
+			else if (const Location* targetLocation = world.Get<Location>(seek.targetEntity)) targetPos = targetLocation->previousPosition;
+			else hasTarget = false;
+
+			float speed = seek.speed * seek.speedScale;
+			Vector2& position = location.position;
+
+			Vector2 direction;
+			if (targetActor && seek.target == pathTarget && flowField.Sample(position, direction))
+			{
+				position.x += direction.x * speed * deltaTime;
+				position.y += direction.y * speed * deltaTime;
+			}
+			else if (hasTarget)
+			{
+				float dx = targetPos.x - position.x;
+				float dy = targetPos.y - position.y;
+				float distance = std::sqrt(dx * dx + dy * dy);
+				if (distance > 0)
+				{
+					position.x += (dx / distance) * speed * deltaTime;
+					position.y += (dy / distance) * speed * deltaTime;
+				}
+			}
+
+			// keep some room from the others, same rule as Enemy::Tick
+			if (seek.separation > 0)
+			{
+				const float separation = seek.separation;
+				const Vector2 self = location.previousPosition;
+				Vector2 push = { 0, 0 };
+				int neighbours = 0;
+
+				grid.QueryRadius(self, separation, [&](uint32_t id, Vector2 other) {
+					if (id == entity.index) return true;
+
+					float dx = self.x - other.x;
+					float dy = self.y - other.y;
+					float distance = std::sqrt(dx * dx + dy * dy);
+					if (distance > 0)
+					{
+						float weight = (separation - distance) / (separation * distance);
+						push.x += dx * weight;
+						push.y += dy * weight;
+					}
+
+					return ++neighbours < 8;
+				}, 32);
+
+				float length = std::sqrt(push.x * push.x + push.y * push.y);
+				if (length > 1.0f)
+				{
+					push.x /= length;
+					push.y /= length;
+				}
+				position.x += push.x * speed * deltaTime;
+				position.y += push.y * speed * deltaTime;
+			}
+
+			position = flowField.Slide(location.previousPosition, position);
+		});
+	}
+
+	float ContactDamageAt(const std::vector<ContactDamager>& damagers, const EnemySwarm* swarm, Vector2 center, float radius)
+	{
+		float damagePerSecond = swarm ? swarm->GetContactDamageAt(center, radius) : 0.0f;
+		for (const ContactDamager& damager : damagers)
+		{
+			float reach = radius + damager.radius;
+			float dx = damager.position.x - center.x;
+			float dy = damager.position.y - center.y;
+			if (dx * dx + dy * dy <= reach * reach) damagePerSecond += damager.damagePerSecond;
+		}
+		return damagePerSecond;
+	}
+
+	// victims are few (the players), so every victim against every damager stays cheap. legacy
+	// actors that take contact damage are found through their ActorLink
+	void ContactDamageSystem(EntityWorld& world, std::vector<ContactDamager>& damagers, GameMode& gameMode, float deltaTime)
+	{
+		damagers.clear();
+		world.ForEach<Location, ContactDamage>([&](Entity, Location& location, ContactDamage& damage) {
+			damagers.push_back({ location.position, damage.radius, damage.damagePerSecond });
+		});
+
+		const EnemySwarm* swarm = &gameMode.GetEnemySwarm();
+
+		world.ForEach<Location, Health, ContactVictim>([&](Entity, Location& location, Health& health, ContactVictim& victim) {
+			float damagePerSecond = ContactDamageAt(damagers, swarm, location.position, victim.radius);
+			health.current -= damagePerSecond * deltaTime;
+			if (health.current < 0) health.current = 0;
+		});
+
+		// the swarm already hits actors in GameMode::ResolveContacts, only add ours
+		if (damagers.empty()) return;
+
+		world.ForEach<ActorLink>([&](Entity, ActorLink& link) {
+			Actor* actor = link.actor;
+			if (!actor->IsActive() || !actor->TakesContactDamage()) return;
+
+			float damagePerSecond = ContactDamageAt(damagers, nullptr, actor->GetPosition(), actor->GetCollisionRadius());
+			if (damagePerSecond > 0) actor->TakeDamage(damagePerSecond * deltaTime);
+		});
+	}
+
+} // namespace
+
+Entity SpawnPlayerEntity(EntityWorld& world, Vector2 location)
+{
+	return world.Create(
+		Location{ location, location },
+		PlayerControl{ 200.0f },
+		Health{ 100.0f, 100.0f },
+		ContactVictim{ 20.0f },
+		Sprite{ kSpritePlayer, 40.0f, WHITE },
+		HealthBar{ 50.0f, 5.0f, -30.0f, GREEN });
+}
+
+Entity SpawnEnemyEntity(EntityWorld& world, Vector2 location, ActorHandle target)
+{
+	return world.Create(
+		Location{ location, location },
+		Seek{ target, Entity(), 50.0f, 1.0f, 30.0f },
+		Health{ 50.0f, 50.0f },
+		ContactDamage{ 15.0f, 10.0f },
+		Sprite{ kSpriteEnemy, 30.0f, WHITE },
+		HealthBar{ 40.0f, 4.0f, -25.0f, ORANGE });
+}
+
+Entity SpawnEnemyEntity(EntityWorld& world, Vector2 location, Entity target)
+{
+	Entity entity = SpawnEnemyEntity(world, location, ActorHandle());
+	world.Get<Seek>(entity)->targetEntity = target;
+	return entity;
+}
+
+void RunEcsSystems(EntityWorld& world, EcsSystemState& state, GameMode& gameMode, float deltaTime)
+{
+	SnapshotTransforms(world, gameMode.GetJobSystem());
+	StatusEffectSystem(world, deltaTime);
+	PlayerControlSystem(world, gameMode.GetFlowField(), gameMode.GetCameraBounds(), gameMode.GetInput(), deltaTime);
+	SyncSeekGrid(world, state.seekGrid);
+	EnemySeekSystem(world, state.seekGrid, gameMode, deltaTime);
+	ContactDamageSystem(world, state.damagers, gameMode, deltaTime);
+
+	world.FlushDeferred();
+}
+
+EcsDrawCounts DrawEcsEntities(EntityWorld& world, RenderCommandList& commands, float alpha, const Rectangle* view)
+{
+	auto outside = [view](Vector2 position) {
+		return view && (position.x < view->x || position.x > view->x + view->width
+			|| position.y < view->y || position.y > view->y + view->height);
+	};
+
+	EcsDrawCounts counts = {};
+	world.ForEach<Location, Sprite>([&](Entity, Location& location, Sprite& sprite) {
+		++counts.total;
+		if (outside(location.position)) return;
+		++counts.visible;
+
+		Vector2 drawPos = {
+			location.previousPosition.x + (location.position.x - location.previousPosition.x) * alpha,
+			location.previousPosition.y + (location.position.y - location.previousPosition.y) * alpha,
+		};
+
+		commands.PushSprite(sprite.id, drawPos.x - sprite.size * 0.5f, drawPos.y - sprite.size * 0.5f, sprite.size, sprite.size, sprite.tint);
+	});
+
+	world.ForEach<Location, Health, HealthBar>([&](Entity, Location& location, Health& health, HealthBar& bar) {
+		if (health.current <= 0 || outside(location.position)) return;
+
+		float x = location.previousPosition.x + (location.position.x - location.previousPosition.x) * alpha - bar.width * 0.5f;
+		float y = location.previousPosition.y + (location.position.y - location.previousPosition.y) * alpha + bar.offsetY;
+		commands.PushRect(x, y, bar.width, bar.height, LIGHTGRAY);
+		commands.PushRect(x, y, bar.width * (health.current / health.max), bar.height, bar.fillColor);
+	});
+
+	return counts;
+}
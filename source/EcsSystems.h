@@ -0,0 +1,49 @@
+#pragma once
+#ifndef ECSSYSTEMS_H
+#define ECSSYSTEMS_H
+
+#include "EntityWorld.h"
+#include "EcsComponents.h"
+#include "SpatialGrid.h"
+#include <vector>
+
+class GameMode;
+class RenderCommandList;
+
+// Player and Enemy behaviour as systems over the game mode's EntityWorld.
+// GameMode::Update runs RunEcsSystems after the actor ticks, GameMode::Draw runs DrawEcsEntities
+
+// entities with the components the Player / Enemy classes have
+Entity SpawnPlayerEntity(EntityWorld& world, Vector2 location);
+Entity SpawnEnemyEntity(EntityWorld& world, Vector2 location, ActorHandle target);
+Entity SpawnEnemyEntity(EntityWorld& world, Vector2 location, Entity target);
+
+// a ContactDamage entity as ContactDamageSystem sees it
+struct ContactDamager {
+	Vector2 position;
+	float radius;
+	float damagePerSecond;
+};
+
+// what the systems keep from tick to tick, one per world (GameMode owns it next to its EntityWorld)
+struct EcsSystemState {
+	EcsSystemState() : seekGrid(30.0f, 4096) { }
+
+	SpatialGrid seekGrid;                 // Seek entities by Entity::index at their start-of-tick position, for separation
+	std::vector<ContactDamager> damagers; // refilled every tick, keeps its capacity
+};
+
+// start-of-tick snapshot, status effects, movement, contact damage and deaths, in that order.
+// structural changes are deferred and flushed at the end
+void RunEcsSystems(EntityWorld& world, EcsSystemState& state, GameMode& gameMode, float deltaTime);
+
+// sprites drawn / sprites there are
+struct EcsDrawCounts {
+	size_t visible;
+	size_t total;
+};
+
+// with a view rect, entities whose position is outside it are skipped (pad it by the sprite size)
+EcsDrawCounts DrawEcsEntities(EntityWorld& world, RenderCommandList& commands, float alpha, const Rectangle* view = nullptr);
+
+#endif // ECSSYSTEMS_H
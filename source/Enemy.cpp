@@ -1,48 +1,118 @@
 #include "Enemy.h"
+#include "GameMode.h"
+#include "RenderCommands.h"
+#include "GameSprites.h"
 #include <cmath>
 
 Enemy::Enemy()
 	: speed(50.0f)
 	, health(50.0f)
-	, target(nullptr)
+	, target()
+	, steer({ 0, 0 })
 {
 	actorName = "Enemy";
 }
 
 void Enemy::BeginPlay() {
 	// spawn at random position
-	position.x = static_cast<float>(GetRandomValue(50, 750));
-	position.y = static_cast<float>(GetRandomValue(50, 550));
+	position.x = static_cast<float>(GetRandom().RangeInt(50, 750));
+	position.y = static_cast<float>(GetRandom().RangeInt(50, 550));
+}
+
+void Enemy::Think() {
+	GameMode* gameMode = GetGameMode();
+	if (!gameMode || health <= 0) return;
+
+	// lost our target, go after whatever the level's path target is
+	if (!gameMode->ResolveActor(target) && target.IsSet()) target = gameMode->GetPathTarget();
+
+	// the path target has a flow field around the walls, follow it until we share its cell
+	Vector2 direction;
+	bool followField = target == gameMode->GetPathTarget() && gameMode->GetFlowField().Sample(position, direction);
+	steer = followField ? direction : Vector2{ 0, 0 };
 }
 
 void Enemy::Tick(float deltaTime) {
+	// dead enemies leave at the end of the frame
+	if (health <= 0)
+	{
+		if (GetGameMode()) GetGameMode()->DestroyActor(this);
+		return;
+	}
+
 	// ai: if target exists move towards it
-	if (target && health > 0)
+	Actor* targetActor = GetGameMode() ? GetGameMode()->ResolveActor(target) : nullptr;
+	if (targetActor)
 	{
-		Vector2 targetPos = target->GetPosition();
+		Vector2 targetPos = targetActor->GetPreviousPosition(); // target may be ticking right now
 
 		// calculate direction to target
 		float dx = targetPos.x - position.x;
 		float dy = targetPos.y - position.y;
 		float distance = std::sqrt(dx * dx + dy * dy);
 
-		if (distance > 0)
+		// Think may have picked a path, it can be a few ticks old during big waves
+		if (steer.x != 0 || steer.y != 0)
+		{
+			position.x += steer.x * speed * deltaTime;
+			position.y += steer.y * speed * deltaTime;
+		}
+		else if (distance > 0)
 		{
 			// move towards target
 			position.x += (dx / distance) * speed * deltaTime;
 			position.y += (dy / distance) * speed * deltaTime;
 		}
 	}
+
+	// keep some room from other enemies. the grid holds start-of-tick positions, so this is race free
+	if (GetGameMode())
+	{
+		const SpatialGrid& grid = GetGameMode()->GetActorGrid();
+		const float separation = 2.0f * GetCollisionRadius();
+		Vector2 self = GetPreviousPosition();
+		Vector2 push = { 0, 0 };
+		int neighbours = 0;
+
+		grid.QueryRadius(self, separation, [&](uint32_t id, Vector2 other) {
+			if (id == GetHandle().index || grid.GetTag(id) != GetTypeId()) return true;
+
+			float dx = self.x - other.x;
+			float dy = self.y - other.y;
+			float distance = std::sqrt(dx * dx + dy * dy);
+			if (distance > 0)
+			{
+				float weight = (separation - distance) / (separation * distance);
+				push.x += dx * weight;
+				push.y += dy * weight;
+			}
+
+			return ++neighbours < 8; // a handful is enough, keeps dense piles from going quadratic
+		}, 32);
+
+		float length = std::sqrt(push.x * push.x + push.y * push.y);
+		if (length > 1.0f)
+		{
+			push.x /= length;
+			push.y /= length;
+		}
+		position.x += push.x * speed * deltaTime;
+		position.y += push.y * speed * deltaTime;
+
+		position = GetGameMode()->GetFlowField().Slide(GetPreviousPosition(), position);
+	}
 }
 
-void Enemy::Draw()
+void Enemy::Draw(RenderCommandList& commands)
 {
 	if (health <= 0) return;  // FIXED: removed extra 'r'
 
+	Vector2 drawPos = GetRenderPosition();
+
 	// draw enemy as a red square
-	DrawRectangle(position.x - 15, position.y - 15, 30, 30, RED);
+	commands.PushSprite(kSpriteEnemy, drawPos.x - 15, drawPos.y - 15, 30, 30);
 
 	// draw enemy health bar
-	DrawRectangle(position.x - 20, position.y - 25, 40, 4, LIGHTGRAY);  // FIXED: LightGray -> LIGHTGRAY
-	DrawRectangle(position.x - 20, position.y - 25, 40 * (health / 50.0f), 4, ORANGE);  // FIXED: parentheses and syntax
+	commands.PushRect(drawPos.x - 20, drawPos.y - 25, 40, 4, LIGHTGRAY);  // FIXED: LightGray -> LIGHTGRAY
+	commands.PushRect(drawPos.x - 20, drawPos.y - 25, 40 * (health / 50.0f), 4, ORANGE);  // FIXED: parentheses and syntax
 }
\ No newline at end of file
@@ -8,17 +8,27 @@ class Enemy : public Actor{
 public:
 	Enemy();
 	virtual void BeginPlay() override;
+	static constexpr bool kParallelBeginPlay = true; // only draws from its own GetRandom()
+	static constexpr size_t kTickGrainSize = 64;     // separation queries make every tick worth a job
+	virtual void Think() override;
 	virtual void Tick(float deltaTime) override;
-	virtual void Draw() override;
+	virtual void Draw(RenderCommandList& commands) override;
 
-	void SetTarget(Actor* newTarget) { target = newTarget; }	
-	void TakeDamage(float amount) {
+	void SetTarget(ActorHandle newTarget) { target = newTarget; }
+	void SetTarget(Actor* newTarget) { target = newTarget ? newTarget->GetHandle() : ActorHandle(); }
+	virtual void TakeDamage(float amount) override {
 		health -= amount;}
 
+	virtual float GetHealth() const override { return health; }
+
+	virtual float GetCollisionRadius() const override { return 15.0f; }
+	virtual float GetContactDamage() const override { return 10.0f; }
+
 private:
 	float speed;
 	float health;
-	Actor* target; // Pointer to the player or other target
+	ActorHandle target; // the player or other target, resolves to nullptr once it is destroyed
+	Vector2 steer;      // flow field direction from the last Think, zero = chase the target directly
 
 };
 
@@ -0,0 +1,532 @@
+#include "EnemySwarm.h"
+#include "Actor.h"
+#include "GameMode.h"
+#include "SeekKernel.h"
+#include "JobSystem.h"
+#include "RenderCommands.h"
+#include "GameSprites.h"
+#include <algorithm>
+#include <cmath>
+
+// handle forwards
+bool EnemyHandle::IsValid() const { return swarm && swarm->IsAlive(*this); }
+void EnemyHandle::SetPosition(Vector2 newPos) { swarm->SetPosition(*this, newPos); }
+Vector2 EnemyHandle::GetPosition() const { return swarm->GetPosition(*this); }
+void EnemyHandle::SetTarget(Actor* newTarget) { swarm->SetTarget(*this, newTarget); }
+void EnemyHandle::TakeDamage(float amount) { swarm->TakeDamage(*this, amount); }
+float EnemyHandle::GetHealth() const { return swarm->GetHealth(*this); }
+void EnemyHandle::Destroy() { if (swarm) swarm->Destroy(*this); }
+
+EnemySwarm::EnemySwarm(GameMode* owner)
+	: gameMode(owner)
+	, flowField(nullptr)
+	, tickLod(nullptr)
+	, tickedCount(0)
+	, tickedLastTick(0)
+	, grid(2.0f * kCollisionRadius, 16384)
+{ }
+
+void EnemySwarm::Reserve(size_t count)
+{
+	posX.reserve(count);
+	posY.reserve(count);
+	prevX.reserve(count);
+	prevY.reserve(count);
+	speed.reserve(count);
+	health.reserve(count);
+	targetIndex.reserve(count);
+	steerX.reserve(count);
+	steerY.reserve(count);
+	lodTime.reserve(count);
+	stepLength.reserve(count);
+	slotOf.reserve(count);
+	seekTargetX.reserve(count);
+	seekTargetY.reserve(count);
+	slots.reserve(count);
+}
+
+void EnemySwarm::Clear()
+{
+	// every live slot gets a new generation so handles from before the clear stay stale
+	for (uint32_t slot : slotOf)
+	{
+		++slots[slot].generation;
+		if (slots[slot].generation == 0) slots[slot].generation = 1;
+		freeSlots.push_back(slot);
+	}
+
+	posX.clear();
+	posY.clear();
+	prevX.clear();
+	prevY.clear();
+	speed.clear();
+	health.clear();
+	targetIndex.clear();
+	steerX.clear();
+	steerY.clear();
+	lodTime.clear();
+	stepLength.clear();
+	slotOf.clear();
+	seekTargetX.clear();
+	seekTargetY.clear();
+	targets.clear();
+	targetPositions.clear();
+	targetAlive.clear();
+	grid.Clear();
+
+	std::lock_guard<std::mutex> lock(pendingMutex);
+	pendingDestroy.clear();
+}
+
+EnemyHandle EnemySwarm::Spawn()
+{
+	// spawn at random position
+	float x = static_cast<float>(rng.RangeInt(50, 750));
+	float y = static_cast<float>(rng.RangeInt(50, 550));
+	return Spawn({ x, y });
+}
+
+void EnemySwarm::SpawnWave(size_t count, Actor* target)
+{
+	spawnScratch.resize(count * 2);
+	rng.FillRangeInt(spawnScratch.data(), count, 50, 750);
+	rng.FillRangeInt(spawnScratch.data() + count, count, 50, 550);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		EnemyHandle enemy = Spawn({ static_cast<float>(spawnScratch[i]), static_cast<float>(spawnScratch[count + i]) });
+		enemy.SetTarget(target);
+	}
+}
+
+EnemyHandle EnemySwarm::Spawn(Vector2 location)
+{
+	uint32_t index = static_cast<uint32_t>(posX.size());
+
+	uint32_t slot;
+	if (!freeSlots.empty())
+	{
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
+	{
+		slot = static_cast<uint32_t>(slots.size());
+		slots.push_back({ 0, 1 });
+	}
+	slots[slot].denseIndex = index;
+
+	// same defaults as Enemy
+	posX.push_back(location.x);
+	posY.push_back(location.y);
+	prevX.push_back(location.x);
+	prevY.push_back(location.y);
+	speed.push_back(50.0f);
+	health.push_back(50.0f);
+	targetIndex.push_back(-1);
+	steerX.push_back(0.0f);
+	steerY.push_back(0.0f);
+	lodTime.push_back(0.0f);
+	stepLength.push_back(0.0f);
+	slotOf.push_back(slot);
+	seekTargetX.push_back(location.x);
+	seekTargetY.push_back(location.y);
+	grid.Insert(slot, location);
+
+	return EnemyHandle(this, slot, slots[slot].generation);
+}
+
+void EnemySwarm::Destroy(EnemyHandle enemy)
+{
+	std::lock_guard<std::mutex> lock(pendingMutex);
+	pendingDestroy.push_back(enemy);
+}
+
+int64_t EnemySwarm::GetDenseIndex(EnemyHandle enemy) const
+{
+	if (enemy.GetSlot() >= slots.size()) return -1;
+
+	const EnemySlot& slot = slots[enemy.GetSlot()];
+	if (slot.generation != enemy.GetGeneration()) return -1;
+	return slot.denseIndex;
+}
+
+void EnemySwarm::SetPosition(EnemyHandle enemy, Vector2 newPos)
+{
+	int64_t index = GetDenseIndex(enemy);
+	if (index < 0) return;
+
+	// a teleport, don't interpolate across it
+	posX[index] = prevX[index] = newPos.x;
+	posY[index] = prevY[index] = newPos.y;
+	grid.Move(slotOf[index], newPos);
+}
+
+Vector2 EnemySwarm::GetPosition(EnemyHandle enemy) const
+{
+	int64_t index = GetDenseIndex(enemy);
+	if (index < 0) return { 0, 0 };
+
+	return { posX[index], posY[index] };
+}
+
+void EnemySwarm::SetTarget(EnemyHandle enemy, Actor* newTarget)
+{
+	int64_t index = GetDenseIndex(enemy);
+	if (index < 0) return;
+
+	targetIndex[index] = newTarget ? FindOrAddTarget(newTarget->GetHandle()) : -1;
+}
+
+void EnemySwarm::TakeDamage(EnemyHandle enemy, float amount)
+{
+	int64_t index = GetDenseIndex(enemy);
+	if (index < 0) return;
+
+	health[index] -= amount;
+}
+
+float EnemySwarm::GetHealth(EnemyHandle enemy) const
+{
+	int64_t index = GetDenseIndex(enemy);
+	return index < 0 ? 0.0f : health[index];
+}
+
+int32_t EnemySwarm::FindOrAddTarget(ActorHandle newTarget)
+{
+	// only ever a few targets (the player), a linear scan is fine
+	for (size_t i = 0; i < targets.size(); ++i)
+	{
+		if (targets[i] == newTarget) return static_cast<int32_t>(i);
+	}
+
+	targets.push_back(newTarget);
+	targetPositions.push_back({ 0, 0 });
+	targetAlive.push_back(0);
+	return static_cast<int32_t>(targets.size() - 1);
+}
+
+void EnemySwarm::Tick(float deltaTime, JobSystem* jobs, const TickLod* lod)
+{
+	// targets are actors, read their start-of-tick state like Enemy::Tick does
+	for (size_t t = 0; t < targets.size(); ++t)
+	{
+		Actor* target = gameMode ? gameMode->ResolveActor(targets[t]) : nullptr;
+		targetAlive[t] = target != nullptr;
+		if (target) targetPositions[t] = target->GetPreviousPosition();
+	}
+
+	flowField = gameMode ? &gameMode->GetFlowField() : nullptr;
+	tickLod = lod && lod->enabled ? lod : nullptr;
+	tickedCount = 0;
+
+	if (jobs)
+	{
+		jobs->ParallelFor(0, posX.size(), 4096, [this, deltaTime](size_t begin, size_t end) {
+			TickRange(begin, end, deltaTime);
+		});
+	}
+	else
+	{
+		TickRange(0, posX.size(), deltaTime);
+	}
+
+	tickedLastTick = tickedCount;
+	tickLod = nullptr;
+
+	RemoveDead();
+	SyncGrid();
+}
+
+void EnemySwarm::Think(size_t begin, size_t end)
+{
+	if (!gameMode) return;
+
+	const FlowField& field = gameMode->GetFlowField();
+	const ActorHandle pathTarget = gameMode->GetPathTarget();
+	end = std::min(end, posX.size());
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		steerX[i] = 0;
+		steerY[i] = 0;
+
+		int32_t t = targetIndex[i];
+		if (t < 0 || health[i] <= 0) continue;
+
+		// target gone: switch to the closest one still around
+		if (!gameMode->ResolveActor(targets[t]))
+		{
+			int32_t closest = -1;
+			float closestDistance = 0;
+			for (size_t other = 0; other < targets.size(); ++other)
+			{
+				Actor* candidate = gameMode->ResolveActor(targets[other]);
+				if (!candidate) continue;
+
+				Vector2 p = candidate->GetPreviousPosition();
+				float distance = (p.x - posX[i]) * (p.x - posX[i]) + (p.y - posY[i]) * (p.y - posY[i]);
+				if (closest < 0 || distance < closestDistance)
+				{
+					closest = static_cast<int32_t>(other);
+					closestDistance = distance;
+				}
+			}
+
+			targetIndex[i] = t = closest;
+			if (t < 0) continue;
+		}
+
+		Vector2 direction;
+		if (targets[t] == pathTarget && field.Sample({ posX[i], posY[i] }, direction))
+		{
+			steerX[i] = direction.x;
+			steerY[i] = direction.y;
+		}
+	}
+}
+
+void EnemySwarm::TickRange(size_t begin, size_t end, float deltaTime)
+{
+	std::copy(posX.begin() + begin, posX.begin() + end, prevX.begin() + begin);
+	std::copy(posY.begin() + begin, posY.begin() + end, prevY.begin() + begin);
+
+	// how far everyone moves this tick. the kernel runs with dt = 1 on these, so enemies the lod skips
+	// (step 0) stay put and the others cover their banked time in one go
+	size_t ticked = end - begin;
+	if (tickLod)
+	{
+		ticked = 0;
+		for (size_t i = begin; i < end; ++i)
+		{
+			lodTime[i] += deltaTime;
+
+			uint32_t interval = tickLod->GetInterval({ posX[i], posY[i] });
+			if (tickLod->IsDue(slotOf[i], interval))
+			{
+				stepLength[i] = speed[i] * lodTime[i];
+				lodTime[i] = 0;
+				++ticked;
+			}
+			else
+			{
+				stepLength[i] = 0;
+			}
+		}
+	}
+	else
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			stepLength[i] = speed[i] * deltaTime;
+		}
+	}
+	tickedCount += ticked;
+
+	// separation first, while posX/posY still match the start-of-tick positions in the grid
+	Separate(begin, end);
+
+	// gather each enemy's target so the kernel only sees flat arrays.
+	// no target means "seek to where you are", which the kernel treats as not moving
+	for (size_t i = begin; i < end; ++i)
+	{
+		int32_t t = targetIndex[i];
+		bool hasTarget = t >= 0 && targetAlive[t];
+		seekTargetX[i] = hasTarget ? targetPositions[t].x : posX[i];
+		seekTargetY[i] = hasTarget ? targetPositions[t].y : posY[i];
+
+		// around walls: aim one cell ahead along the direction Think picked, the kernel only needs a direction
+		if (hasTarget && (steerX[i] != 0 || steerY[i] != 0))
+		{
+			seekTargetX[i] = posX[i] + steerX[i] * flowField->GetCellSize();
+			seekTargetY[i] = posY[i] + steerY[i] * flowField->GetCellSize();
+		}
+	}
+
+	SeekBatch batch;
+	batch.posX = posX.data() + begin;
+	batch.posY = posY.data() + begin;
+	batch.targetX = seekTargetX.data() + begin;
+	batch.targetY = seekTargetY.data() + begin;
+	batch.speed = stepLength.data() + begin;
+	batch.health = health.data() + begin;
+	batch.count = end - begin;
+
+	SeekKernel(batch, 1.0f);
+
+	if (flowField && flowField->HasWalls())
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			Vector2 moved = flowField->Slide({ prevX[i], prevY[i] }, { posX[i], posY[i] });
+			posX[i] = moved.x;
+			posY[i] = moved.y;
+		}
+	}
+}
+
+void EnemySwarm::Separate(size_t begin, size_t end)
+{
+	// same rule as Enemy::Tick: push away from up to 8 neighbours closer than two radii, looking at no
+	// more than 32 candidates. neighbours come from the grid, which holds start-of-tick positions, so
+	// other ranges moving their enemies at the same time does not matter
+	const float separation = 2.0f * kCollisionRadius;
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		if (health[i] <= 0 || stepLength[i] == 0) continue;
+
+		const uint32_t self = slotOf[i];
+		const Vector2 selfPos = { posX[i], posY[i] };
+		Vector2 push = { 0, 0 };
+		int neighbours = 0;
+
+		grid.QueryRadius(selfPos, separation, [&](uint32_t id, Vector2 other) {
+			if (id == self) return true;
+
+			float dx = selfPos.x - other.x;
+			float dy = selfPos.y - other.y;
+			float distance = std::sqrt(dx * dx + dy * dy);
+			if (distance > 0)
+			{
+				float weight = (separation - distance) / (separation * distance);
+				push.x += dx * weight;
+				push.y += dy * weight;
+			}
+
+			return ++neighbours < 8;
+		}, 32);
+
+		float length = std::sqrt(push.x * push.x + push.y * push.y);
+		if (length > 1.0f)
+		{
+			push.x /= length;
+			push.y /= length;
+		}
+		posX[i] += push.x * stepLength[i];
+		posY[i] += push.y * stepLength[i];
+	}
+}
+
+void EnemySwarm::SyncGrid()
+{
+	const size_t count = posX.size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		grid.Move(slotOf[i], { posX[i], posY[i] });
+	}
+}
+
+float EnemySwarm::GetContactDamageAt(Vector2 center, float radius) const
+{
+	int touching = 0;
+	grid.QueryRadius(center, radius + kCollisionRadius, [&](uint32_t, Vector2) { ++touching; });
+	return touching * kContactDamage;
+}
+
+void EnemySwarm::RemoveAt(size_t index)
+{
+	size_t last = posX.size() - 1;
+
+	// retire the slot first so the handle goes stale
+	uint32_t slot = slotOf[index];
+	grid.Remove(slot);
+	++slots[slot].generation;
+	if (slots[slot].generation == 0) slots[slot].generation = 1;
+	freeSlots.push_back(slot);
+
+	if (index != last)
+	{
+		posX[index] = posX[last];
+		posY[index] = posY[last];
+		prevX[index] = prevX[last];
+		prevY[index] = prevY[last];
+		speed[index] = speed[last];
+		health[index] = health[last];
+		targetIndex[index] = targetIndex[last];
+		steerX[index] = steerX[last];
+		steerY[index] = steerY[last];
+		lodTime[index] = lodTime[last];
+		slotOf[index] = slotOf[last];
+		slots[slotOf[index]].denseIndex = static_cast<uint32_t>(index);
+	}
+
+	posX.pop_back();
+	posY.pop_back();
+	prevX.pop_back();
+	prevY.pop_back();
+	speed.pop_back();
+	health.pop_back();
+	targetIndex.pop_back();
+	steerX.pop_back();
+	steerY.pop_back();
+	lodTime.pop_back();
+	stepLength.pop_back();
+	slotOf.pop_back();
+	seekTargetX.pop_back();
+	seekTargetY.pop_back();
+}
+
+void EnemySwarm::RemoveDead()
+{
+	{
+		// explicit destroys just zero the health, the sweep below does the rest
+		std::lock_guard<std::mutex> lock(pendingMutex);
+		for (EnemyHandle enemy : pendingDestroy)
+		{
+			int64_t index = GetDenseIndex(enemy);
+			if (index >= 0) health[index] = 0;
+		}
+		pendingDestroy.clear();
+	}
+
+	// walk backwards so the enemy swapped into a hole has already been checked
+	for (size_t i = posX.size(); i-- > 0;)
+	{
+		if (health[i] <= 0) RemoveAt(i);
+	}
+}
+
+void EnemySwarm::DrawEnemy(RenderCommandList& commands, size_t index, float alpha) const
+{
+	float x = prevX[index] + (posX[index] - prevX[index]) * alpha;
+	float y = prevY[index] + (posY[index] - prevY[index]) * alpha;
+
+	// same look as Enemy::Draw
+	commands.PushSprite(kSpriteEnemy, x - 15, y - 15, 30, 30);
+	commands.PushRect(x - 20, y - 25, 40, 4, LIGHTGRAY);
+	commands.PushRect(x - 20, y - 25, 40 * (health[index] / 50.0f), 4, ORANGE);
+}
+
+void EnemySwarm::Draw(RenderCommandList& commands, float alpha)
+{
+	const size_t count = posX.size();
+	commands.Reserve(count * 3);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (health[i] > 0) DrawEnemy(commands, i, alpha);
+	}
+}
+
+size_t EnemySwarm::DrawVisible(RenderCommandList& commands, float alpha, Rectangle view)
+{
+	visibleScratch.clear();
+	grid.QueryRect(view, [this](uint32_t slot, Vector2) {
+		visibleScratch.push_back(slots[slot].denseIndex);
+	});
+
+	// the grid hands them out cell by cell, dense order walks the arrays forwards and keeps the
+	// overlap order the same as Draw's
+	std::sort(visibleScratch.begin(), visibleScratch.end());
+	commands.Reserve(visibleScratch.size() * 3);
+
+	size_t drawn = 0;
+	for (uint32_t i : visibleScratch)
+	{
+		if (health[i] <= 0) continue;
+		DrawEnemy(commands, i, alpha);
+		++drawn;
+	}
+	return drawn;
+}
@@ -0,0 +1,173 @@
+#pragma once
+#ifndef ENEMYSWARM_H
+#define ENEMYSWARM_H
+
+#include "raylib.h"
+#include "ActorHandle.h"
+#include "SpatialGrid.h"
+#include "TickLod.h"
+#include "Random.h"
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+class Actor;
+class EnemySwarm;
+class GameMode;
+class JobSystem;
+class RenderCommandList;
+class FlowField;
+
+// lightweight handle into an EnemySwarm, gives gameplay code the same calls it had on Enemy.
+// like ActorHandle it is slot + generation, so it goes stale (IsValid() == false) once the enemy
+// is removed instead of pointing at whichever enemy got moved into its place
+class EnemyHandle {
+public:
+	EnemyHandle() : swarm(nullptr), slot(0), generation(0) {}
+	EnemyHandle(EnemySwarm* owner, uint32_t enemySlot, uint32_t enemyGeneration)
+		: swarm(owner), slot(enemySlot), generation(enemyGeneration) {}
+
+	bool IsValid() const;
+	uint32_t GetSlot() const { return slot; }
+	uint32_t GetGeneration() const { return generation; }
+
+	void SetPosition(Vector2 newPos);
+	Vector2 GetPosition() const;
+
+	void SetTarget(Actor* newTarget);
+	void TakeDamage(float amount);
+	float GetHealth() const;
+
+	void Destroy();
+
+private:
+	EnemySwarm* swarm;
+	uint32_t slot;
+	uint32_t generation;
+};
+
+// every enemy lives in contiguous structure-of-arrays buffers instead of its own heap object,
+// so Tick is one tight loop over floats with no vtable or pointer chasing per enemy.
+// dead enemies (health <= 0) and destroyed ones are swap-and-popped out at the end of Tick.
+class EnemySwarm {
+public:
+	// targets are actor handles resolved through the owning game mode
+	explicit EnemySwarm(GameMode* owner);
+
+	void Reserve(size_t count);
+	void Clear();
+	size_t Size() const { return posX.size(); }
+
+	EnemyHandle Spawn();                  // random position, same as Enemy::BeginPlay
+	EnemyHandle Spawn(Vector2 location);
+
+	// count enemies at random positions chasing target, positions drawn in one batch
+	void SpawnWave(size_t count, Actor* target);
+
+	// spawn positions come from the swarm's own stream, GameMode::SetWorldSeed sets it
+	void SetRandomSeed(uint64_t seed) { rng.Seed(seed, kRngStreamSwarm); }
+
+	// deferred to the end of the next Tick, safe to call from actor ticks
+	void Destroy(EnemyHandle enemy);
+
+	// enemies only read their own slot and the target snapshot, so ranges tick in parallel when jobs is given.
+	// with a lod, enemies that aren't due this tick don't move and get the banked time on their next one
+	void Tick(float deltaTime, JobSystem* jobs = nullptr, const TickLod* lod = nullptr);
+	size_t GetTickedLastTick() const { return tickedLastTick; }
+
+	// decisions for enemies [begin, end): retarget when the target is gone, refresh the flow field
+	// direction. run by the game mode's AIScheduler, Tick keeps moving by the last decision
+	void Think(size_t begin, size_t end);
+
+	// alpha blends between the previous and current tick positions (see GameMode::Advance)
+	void Draw(RenderCommandList& commands, float alpha = 1.0f);
+	// only the enemies the grid has inside view (pad it by how far a tick moves them plus their size),
+	// in dense order. returns how many were drawn
+	size_t DrawVisible(RenderCommandList& commands, float alpha, Rectangle view);
+
+	// damage per second the enemies overlapping a circle deal to it (contact damage)
+	float GetContactDamageAt(Vector2 center, float radius) const;
+
+	// enemies by handle slot, holds start-of-tick positions while Tick runs
+	const SpatialGrid& GetGrid() const { return grid; }
+
+	// same size/damage as Enemy
+	static constexpr float kCollisionRadius = 15.0f;
+	static constexpr float kContactDamage = 10.0f;
+
+	// raw state by dense index [0, Size()) for tools (checksums, debug views). the order changes
+	// whenever an enemy is removed, GetSlotAt is the stable id
+	Vector2 GetPositionAt(size_t index) const { return { posX[index], posY[index] }; }
+	float GetHealthAt(size_t index) const { return health[index]; }
+	uint32_t GetSlotAt(size_t index) const { return slotOf[index]; }
+
+	// per enemy access through handles, -1 when the handle is stale
+	int64_t GetDenseIndex(EnemyHandle enemy) const;
+	bool IsAlive(EnemyHandle enemy) const { return GetDenseIndex(enemy) >= 0; }
+
+	void SetPosition(EnemyHandle enemy, Vector2 newPos);
+	Vector2 GetPosition(EnemyHandle enemy) const;
+	void SetTarget(EnemyHandle enemy, Actor* newTarget);
+	void TakeDamage(EnemyHandle enemy, float amount);
+	float GetHealth(EnemyHandle enemy) const;
+
+private:
+	struct EnemySlot {
+		uint32_t denseIndex;
+		uint32_t generation;
+	};
+
+	int32_t FindOrAddTarget(ActorHandle newTarget);
+	void TickRange(size_t begin, size_t end, float deltaTime);
+	void Separate(size_t begin, size_t end);
+	void RemoveDead();
+	void RemoveAt(size_t index);
+	void SyncGrid();
+	void DrawEnemy(RenderCommandList& commands, size_t index, float alpha) const;
+
+	GameMode* gameMode;
+	const FlowField* flowField;           // set for the duration of a Tick
+	const TickLod* tickLod;               // same, nullptr = everybody every tick
+	std::atomic<size_t> tickedCount;
+	size_t tickedLastTick;
+	Rng rng;
+	std::vector<int> spawnScratch;    // SpawnWave's coordinates
+	std::vector<uint32_t> visibleScratch; // DrawVisible's dense indices
+
+	// enemy data, one entry per enemy
+	std::vector<float> posX;
+	std::vector<float> posY;
+	std::vector<float> prevX;         // positions before the last tick, for render interpolation
+	std::vector<float> prevY;
+	std::vector<float> speed;
+	std::vector<float> health;
+	std::vector<int32_t> targetIndex; // into targets, -1 for none
+	std::vector<float> steerX;        // flow field direction from the last Think, zero = seek the target directly
+	std::vector<float> steerY;
+	std::vector<float> lodTime;       // dt banked while skipped by the tick lod
+	std::vector<uint32_t> slotOf;     // dense index -> slot, to fix up handles on swap-and-pop
+
+	// per enemy target position gathered each tick for the seek kernel
+	std::vector<float> seekTargetX;
+	std::vector<float> seekTargetY;
+	std::vector<float> stepLength;    // speed * this enemy's dt for the current tick, 0 when skipped
+
+	SpatialGrid grid;
+
+	// handle slots, reused through freeSlots
+	std::vector<EnemySlot> slots;
+	std::vector<uint32_t> freeSlots;
+
+	std::mutex pendingMutex;
+	std::vector<EnemyHandle> pendingDestroy;
+
+	// the handful of actors enemies chase, positions are snapshotted once per tick.
+	// a destroyed target just stops being chased
+	std::vector<ActorHandle> targets;
+	std::vector<Vector2> targetPositions;
+	std::vector<char> targetAlive;
+};
+
+#endif // ENEMYSWARM_H
@@ -0,0 +1,278 @@
+#include "EntityWorld.h"
+#include "EcsComponents.h"
+#include <algorithm>
+#include <array>
+#include <new>
+
+namespace {
+
+	struct ComponentInfo {
+		size_t size;
+		size_t alignment;
+	};
+
+	template<typename... Cs>
+	constexpr std::array<ComponentInfo, sizeof...(Cs)> MakeComponentInfos(ComponentTypeList<Cs...>)
+	{
+		static_assert((std::is_trivially_copyable<Cs>::value && ...), "components must be plain data");
+		return { { { sizeof(Cs), alignof(Cs) }... } };
+	}
+
+	// indexed by component type id
+	constexpr std::array<ComponentInfo, kComponentTypeCount> componentInfos = MakeComponentInfos(GameComponentTypes());
+
+	const std::align_val_t kChunkAlignment = std::align_val_t(64);
+
+	size_t AlignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+} // namespace
+
+Archetype::Archetype(ComponentMask mask)
+	: mask(mask)
+	, chunkCapacity(1)
+	, chunkBytes(0)
+	, entitiesOffset(0)
+{
+	// how many rows fit once every column has been padded to its alignment
+	size_t rowBytes = sizeof(Entity);
+	size_t padding = alignof(Entity);
+	for (size_t id = 0; id < kComponentTypeCount; ++id)
+	{
+		columnOffset[id] = 0;
+		if (!Has(id)) continue;
+
+		rowBytes += componentInfos[id].size;
+		padding += componentInfos[id].alignment;
+	}
+	if (kChunkBytes > padding + rowBytes) chunkCapacity = (kChunkBytes - padding) / rowBytes;
+
+	size_t offset = chunkCapacity * sizeof(Entity);
+	for (size_t id = 0; id < kComponentTypeCount; ++id)
+	{
+		if (!Has(id)) continue;
+
+		offset = AlignUp(offset, componentInfos[id].alignment);
+		columnOffset[id] = offset;
+		offset += chunkCapacity * componentInfos[id].size;
+	}
+	chunkBytes = offset;
+}
+
+Archetype::~Archetype()
+{
+	for (Chunk& chunk : chunks)
+	{
+		::operator delete(chunk.memory, kChunkAlignment);
+	}
+}
+
+size_t Archetype::Size() const
+{
+	if (chunks.empty()) return 0;
+	return (chunks.size() - 1) * chunkCapacity + chunks.back().count;
+}
+
+std::pair<uint32_t, uint32_t> Archetype::AddRow(Entity entity)
+{
+	if (chunks.empty() || chunks.back().count == chunkCapacity)
+	{
+		Chunk chunk;
+		chunk.memory = static_cast<unsigned char*>(::operator new(chunkBytes, kChunkAlignment));
+		chunk.count = 0;
+		chunk.entities = reinterpret_cast<Entity*>(chunk.memory + entitiesOffset);
+		chunks.push_back(chunk);
+	}
+
+	Chunk& chunk = chunks.back();
+	uint32_t row = static_cast<uint32_t>(chunk.count++);
+	chunk.entities[row] = entity;
+	return { static_cast<uint32_t>(chunks.size() - 1), row };
+}
+
+Entity Archetype::RemoveRow(uint32_t chunkIndex, uint32_t row)
+{
+	Chunk& last = chunks.back();
+	uint32_t lastChunk = static_cast<uint32_t>(chunks.size() - 1);
+	uint32_t lastRow = static_cast<uint32_t>(last.count - 1);
+
+	Entity moved;
+	if (chunkIndex != lastChunk || row != lastRow)
+	{
+		Chunk& hole = chunks[chunkIndex];
+		for (size_t id = 0; id < kComponentTypeCount; ++id)
+		{
+			if (!Has(id)) continue;
+
+			size_t size = componentInfos[id].size;
+			std::memcpy(hole.memory + columnOffset[id] + row * size, last.memory + columnOffset[id] + lastRow * size, size);
+		}
+		moved = last.entities[lastRow];
+		hole.entities[row] = moved;
+	}
+
+	if (--last.count == 0)
+	{
+		::operator delete(last.memory, kChunkAlignment);
+		chunks.pop_back();
+	}
+
+	return moved;
+}
+
+EntityWorld::EntityWorld()
+	: entityCount(0)
+{ }
+
+EntityWorld::~EntityWorld() {}
+
+Entity EntityWorld::NewEntity()
+{
+	uint32_t index;
+	if (!freeRecords.empty())
+	{
+		index = freeRecords.back();
+		freeRecords.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32_t>(records.size());
+		records.push_back({ nullptr, 0, 0, 1 });
+	}
+
+	++entityCount;
+	return { index, records[index].generation };
+}
+
+Archetype* EntityWorld::GetArchetype(ComponentMask mask)
+{
+	auto found = archetypes.find(mask);
+	if (found != archetypes.end()) return found->second.get();
+
+	Archetype* archetype = new Archetype(mask);
+	archetypes.emplace(mask, std::unique_ptr<Archetype>(archetype));
+	archetypeList.push_back(archetype);
+	return archetype;
+}
+
+void EntityWorld::Place(Entity entity, Archetype* archetype)
+{
+	std::pair<uint32_t, uint32_t> slot = archetype->AddRow(entity);
+
+	Record& record = records[entity.index];
+	record.archetype = archetype;
+	record.chunk = slot.first;
+	record.row = slot.second;
+}
+
+void EntityWorld::Unplace(Entity entity)
+{
+	Record& record = records[entity.index];
+	Entity moved = record.archetype->RemoveRow(record.chunk, record.row);
+	if (moved.IsSet())
+	{
+		records[moved.index].chunk = record.chunk;
+		records[moved.index].row = record.row;
+	}
+	record.archetype = nullptr;
+}
+
+void EntityWorld::Move(Entity entity, ComponentMask newMask)
+{
+	Record old = records[entity.index];
+	Archetype* target = GetArchetype(newMask);
+	std::pair<uint32_t, uint32_t> slot = target->AddRow(entity);
+
+	// carry over what both archetypes have, a new component is written by the caller
+	Archetype::Chunk& from = old.archetype->GetChunk(old.chunk);
+	Archetype::Chunk& to = target->GetChunk(slot.first);
+	ComponentMask shared = old.archetype->GetMask() & newMask;
+	for (size_t id = 0; id < kComponentTypeCount; ++id)
+	{
+		if (!((shared >> id) & 1)) continue;
+
+		size_t size = componentInfos[id].size;
+		std::memcpy(static_cast<unsigned char*>(target->Column(to, id)) + slot.second * size,
+			static_cast<unsigned char*>(old.archetype->Column(from, id)) + old.row * size, size);
+	}
+
+	Unplace(entity);
+
+	Record& record = records[entity.index];
+	record.archetype = target;
+	record.chunk = slot.first;
+	record.row = slot.second;
+}
+
+void EntityWorld::Destroy(Entity entity)
+{
+	if (!IsAlive(entity)) return;
+
+	Unplace(entity);
+
+	Record& record = records[entity.index];
+	if (++record.generation == 0) record.generation = 1;
+	freeRecords.push_back(entity.index);
+	--entityCount;
+}
+
+void EntityWorld::DestroyDeferred(Entity entity)
+{
+	Defer([entity](EntityWorld& world) { world.Destroy(entity); });
+}
+
+void EntityWorld::Defer(std::function<void(EntityWorld&)> command)
+{
+	std::lock_guard<std::mutex> lock(deferredMutex);
+	deferred.push_back(std::move(command));
+}
+
+void EntityWorld::FlushDeferred()
+{
+	// commands may defer more commands, keep going until nothing is left
+	std::vector<std::function<void(EntityWorld&)>> commands;
+	for (;;)
+	{
+		{
+			std::lock_guard<std::mutex> lock(deferredMutex);
+			if (deferred.empty()) return;
+			commands.swap(deferred);
+		}
+
+		for (auto& command : commands)
+		{
+			command(*this);
+		}
+		commands.clear();
+	}
+}
+
+void EntityWorld::Clear()
+{
+	for (uint32_t index = 0; index < records.size(); ++index)
+	{
+		Record& record = records[index];
+		if (!record.archetype) continue;
+
+		record.archetype = nullptr;
+		if (++record.generation == 0) record.generation = 1;
+		freeRecords.push_back(index);
+	}
+
+	// archetypes stay, only their rows go
+	for (Archetype* archetype : archetypeList)
+	{
+		while (archetype->GetChunkCount() > 0)
+		{
+			Archetype::Chunk& chunk = archetype->GetChunk(archetype->GetChunkCount() - 1);
+			archetype->RemoveRow(static_cast<uint32_t>(archetype->GetChunkCount() - 1), static_cast<uint32_t>(chunk.count - 1));
+		}
+	}
+
+	entityCount = 0;
+
+	std::lock_guard<std::mutex> lock(deferredMutex);
+	deferred.clear();
+}
@@ -0,0 +1,257 @@
+#pragma once
+#ifndef ENTITYWORLD_H
+#define ENTITYWORLD_H
+
+#include "JobSystem.h"
+#include "ComponentTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// stable reference to an entity, slot index + generation like ActorHandle
+struct Entity {
+	uint32_t index = 0;
+	uint32_t generation = 0; // 0 is never handed out
+
+	bool IsSet() const { return generation != 0; }
+
+	bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const Entity& other) const { return !(*this == other); }
+};
+
+// components are plain data (trivially copyable, moved with memcpy), their ids come from GameComponentTypes
+using ComponentMask = uint64_t;
+static_assert(kComponentTypeCount <= sizeof(ComponentMask) * 8, "widen ComponentMask");
+
+template<typename T>
+constexpr size_t ComponentTypeId()
+{
+	return ComponentTypeIndex<T, GameComponentTypes>::value;
+}
+
+template<typename... Cs>
+constexpr ComponentMask ComponentMaskOf()
+{
+	return (ComponentMask(0) | ... | (ComponentMask(1) << ComponentTypeId<Cs>()));
+}
+
+// every entity with exactly the same set of components lives in the same archetype, in 16 KB chunks
+// laid out column by column (all positions, then all healths, ...), so a query walks flat arrays.
+// removing an entity moves the archetype's last entity into the hole, chunks stay packed
+class Archetype {
+public:
+	static constexpr size_t kChunkBytes = 16 * 1024;
+
+	struct Chunk {
+		unsigned char* memory;
+		size_t count;
+		Entity* entities;
+	};
+
+	explicit Archetype(ComponentMask mask);
+	~Archetype();
+
+	Archetype(const Archetype&) = delete;
+	Archetype& operator=(const Archetype&) = delete;
+
+	ComponentMask GetMask() const { return mask; }
+	size_t GetChunkCapacity() const { return chunkCapacity; }
+	size_t GetChunkCount() const { return chunks.size(); }
+	Chunk& GetChunk(size_t index) { return chunks[index]; }
+	size_t Size() const;
+
+	bool Has(size_t componentId) const { return (mask >> componentId) & 1; }
+
+	template<typename T>
+	T* Column(Chunk& chunk) const { return reinterpret_cast<T*>(chunk.memory + columnOffset[ComponentTypeId<T>()]); }
+	void* Column(Chunk& chunk, size_t componentId) const { return chunk.memory + columnOffset[componentId]; }
+
+	// returns (chunk, row) of a new uninitialized row owned by entity
+	std::pair<uint32_t, uint32_t> AddRow(Entity entity);
+	// fills the hole with the last row, returns the entity that moved into it (unset if none did)
+	Entity RemoveRow(uint32_t chunk, uint32_t row);
+
+private:
+	ComponentMask mask;
+	size_t chunkCapacity;
+	size_t chunkBytes;
+	size_t columnOffset[kComponentTypeCount];
+	size_t entitiesOffset;
+	std::vector<Chunk> chunks;
+};
+
+// entities + archetypes. structural changes (create, destroy, add/remove component) happen on the game
+// thread between systems; from inside a (parallel) query use the Deferred versions, which run on FlushDeferred
+class EntityWorld {
+public:
+	EntityWorld();
+	~EntityWorld();
+
+	EntityWorld(const EntityWorld&) = delete;
+	EntityWorld& operator=(const EntityWorld&) = delete;
+
+	template<typename... Cs>
+	Entity Create(const Cs&... components)
+	{
+		Entity entity = NewEntity();
+		Place(entity, GetArchetype(ComponentMaskOf<Cs...>()));
+		using expand = int[];
+		(void)expand{ 0, (Write(entity, components), 0)... };
+		return entity;
+	}
+
+	void Destroy(Entity entity);
+	bool IsAlive(Entity entity) const
+	{
+		return entity.index < records.size() && records[entity.index].generation == entity.generation && entity.IsSet();
+	}
+
+	template<typename T>
+	void Add(Entity entity, const T& component)
+	{
+		if (!IsAlive(entity)) return;
+		if (!Has<T>(entity)) Move(entity, records[entity.index].archetype->GetMask() | ComponentMaskOf<T>());
+		Write(entity, component);
+	}
+
+	template<typename T>
+	void Remove(Entity entity)
+	{
+		if (!IsAlive(entity) || !Has<T>(entity)) return;
+		Move(entity, records[entity.index].archetype->GetMask() & ~ComponentMaskOf<T>());
+	}
+
+	template<typename T>
+	bool Has(Entity entity) const
+	{
+		return IsAlive(entity) && records[entity.index].archetype->Has(ComponentTypeId<T>());
+	}
+
+	// nullptr when the entity is gone or doesn't have one
+	template<typename T>
+	T* Get(Entity entity)
+	{
+		if (!Has<T>(entity)) return nullptr;
+		const Record& record = records[entity.index];
+		Archetype::Chunk& chunk = record.archetype->GetChunk(record.chunk);
+		return record.archetype->Column<T>(chunk) + record.row;
+	}
+
+	// safe from any thread / inside queries, applied in order by FlushDeferred
+	void DestroyDeferred(Entity entity);
+	template<typename T>
+	void AddDeferred(Entity entity, const T& component)
+	{
+		Defer([entity, component](EntityWorld& world) { world.Add(entity, component); });
+	}
+	template<typename T>
+	void RemoveDeferred(Entity entity)
+	{
+		Defer([entity](EntityWorld& world) { world.Remove<T>(entity); });
+	}
+	void FlushDeferred();
+
+	// fn(Entity, Cs&...) for every entity that has at least Cs...
+	template<typename... Cs, typename Fn>
+	void ForEach(Fn&& fn)
+	{
+		const ComponentMask required = ComponentMaskOf<Cs...>();
+		for (Archetype* archetype : archetypeList)
+		{
+			if ((archetype->GetMask() & required) != required) continue;
+			for (size_t c = 0; c < archetype->GetChunkCount(); ++c)
+			{
+				RunChunk<Cs...>(*archetype, archetype->GetChunk(c), fn);
+			}
+		}
+	}
+
+	// same, matching chunks are spread over the job system. fn must only touch its own entity
+	template<typename... Cs, typename Fn>
+	void ParallelForEach(JobSystem& jobs, Fn&& fn)
+	{
+		const ComponentMask required = ComponentMaskOf<Cs...>();
+		matchedChunks.clear();
+		for (Archetype* archetype : archetypeList)
+		{
+			if ((archetype->GetMask() & required) != required) continue;
+			for (size_t c = 0; c < archetype->GetChunkCount(); ++c)
+			{
+				matchedChunks.push_back({ archetype, c });
+			}
+		}
+
+		jobs.ParallelFor(0, matchedChunks.size(), 1, [this, &fn](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				Archetype& archetype = *matchedChunks[i].first;
+				RunChunk<Cs...>(archetype, archetype.GetChunk(matchedChunks[i].second), fn);
+			}
+		});
+	}
+
+	size_t GetEntityCount() const { return entityCount; }
+	size_t GetArchetypeCount() const { return archetypeList.size(); }
+
+	// destroys every entity, the archetypes stay
+	void Clear();
+
+private:
+	struct Record {
+		Archetype* archetype;
+		uint32_t chunk;
+		uint32_t row;
+		uint32_t generation;
+	};
+
+	template<typename... Cs, typename Fn>
+	static void RunChunk(Archetype& archetype, Archetype::Chunk& chunk, Fn& fn)
+	{
+		RunChunkColumns(chunk, fn, archetype.Column<Cs>(chunk)...);
+	}
+
+	template<typename Fn, typename... Ptrs>
+	static void RunChunkColumns(Archetype::Chunk& chunk, Fn& fn, Ptrs... columns)
+	{
+		const size_t count = chunk.count;
+		for (size_t i = 0; i < count; ++i)
+		{
+			fn(chunk.entities[i], columns[i]...);
+		}
+	}
+
+	template<typename T>
+	void Write(Entity entity, const T& component)
+	{
+		const Record& record = records[entity.index];
+		Archetype::Chunk& chunk = record.archetype->GetChunk(record.chunk);
+		record.archetype->Column<T>(chunk)[record.row] = component;
+	}
+
+	Entity NewEntity();
+	Archetype* GetArchetype(ComponentMask mask);
+	void Place(Entity entity, Archetype* archetype);
+	void Unplace(Entity entity);
+	void Move(Entity entity, ComponentMask newMask);
+	void Defer(std::function<void(EntityWorld&)> command);
+
+	std::unordered_map<ComponentMask, std::unique_ptr<Archetype>> archetypes;
+	std::vector<Archetype*> archetypeList;   // creation order, what queries walk
+	std::vector<Record> records;             // indexed by Entity::index
+	std::vector<uint32_t> freeRecords;
+	size_t entityCount;
+
+	std::vector<std::pair<Archetype*, size_t>> matchedChunks;
+
+	std::mutex deferredMutex;
+	std::vector<std::function<void(EntityWorld&)>> deferred;
+};
+
+#endif // ENTITYWORLD_H
@@ -0,0 +1,171 @@
+#include "FlowField.h"
+#include <algorithm>
+#include <cmath>
+
+FlowField::FlowField(float cellSize, int width, int height)
+	: cellSize(cellSize)
+	, width(width)
+	, height(height)
+	, blocked(static_cast<size_t>(width) * height, 0)
+	, wallCount(0)
+	, wallsChanged(false)
+	, flows(static_cast<size_t>(width) * height, Flow{ 0, 0, -1 })
+	, goalCell(-1)
+	, built(false)
+{
+	openCells.reserve(flows.size());
+}
+
+void FlowField::SetBlocked(int cellX, int cellY, bool isBlocked)
+{
+	if (cellX < 0 || cellY < 0 || cellX >= width || cellY >= height) return;
+
+	uint8_t& cell = blocked[cellY * width + cellX];
+	if (cell == static_cast<uint8_t>(isBlocked)) return;
+
+	cell = isBlocked ? 1 : 0;
+	if (isBlocked) ++wallCount;
+	else --wallCount;
+	wallsChanged = true;
+}
+
+void FlowField::SetBlockedRect(Rectangle rect, bool isBlocked)
+{
+	int minX = static_cast<int>(std::floor(rect.x / cellSize));
+	int minY = static_cast<int>(std::floor(rect.y / cellSize));
+	int maxX = static_cast<int>(std::ceil((rect.x + rect.width) / cellSize)) - 1;
+	int maxY = static_cast<int>(std::ceil((rect.y + rect.height) / cellSize)) - 1;
+
+	for (int y = minY; y <= maxY; ++y)
+	{
+		for (int x = minX; x <= maxX; ++x)
+		{
+			SetBlocked(x, y, isBlocked);
+		}
+	}
+}
+
+void FlowField::ClearWalls()
+{
+	if (wallCount == 0) return;
+
+	std::fill(blocked.begin(), blocked.end(), uint8_t(0));
+	wallCount = 0;
+	wallsChanged = true;
+}
+
+bool FlowField::IsBlocked(int cellX, int cellY) const
+{
+	if (cellX < 0 || cellY < 0 || cellX >= width || cellY >= height) return false;
+	return blocked[cellY * width + cellX] != 0;
+}
+
+bool FlowField::IsBlockedAt(Vector2 position) const
+{
+	if (position.x < 0 || position.y < 0) return false;
+	return IsBlocked(static_cast<int>(position.x / cellSize), static_cast<int>(position.y / cellSize));
+}
+
+bool FlowField::Update(Vector2 goal)
+{
+	int cellX = static_cast<int>(goal.x / cellSize);
+	int cellY = static_cast<int>(goal.y / cellSize);
+	bool inside = goal.x >= 0 && goal.y >= 0 && cellX < width && cellY < height;
+	int newGoalCell = inside ? cellY * width + cellX : -1;
+
+	if (built && !wallsChanged && newGoalCell == goalCell) return false;
+
+	Rebuild(goal);
+	return true;
+}
+
+void FlowField::Rebuild(Vector2 goal)
+{
+	built = true;
+	wallsChanged = false;
+
+	for (Flow& flow : flows)
+	{
+		flow = { 0, 0, -1 };
+	}
+
+	int cellX = static_cast<int>(goal.x / cellSize);
+	int cellY = static_cast<int>(goal.y / cellSize);
+	bool inside = goal.x >= 0 && goal.y >= 0 && cellX < width && cellY < height;
+	goalCell = inside && !blocked[cellY * width + cellX] ? cellY * width + cellX : -1;
+	if (goalCell < 0) return;
+
+	// distances, 4-connected so paths never squeeze diagonally between two walls
+	openCells.clear();
+	openCells.push_back(goalCell);
+	flows[goalCell].distance = 0;
+
+	for (size_t head = 0; head < openCells.size(); ++head)
+	{
+		int cell = openCells[head];
+		int x = cell % width;
+		int y = cell / width;
+		int32_t next = flows[cell].distance + 1;
+
+		const int neighbours[4][2] = { { x - 1, y }, { x + 1, y }, { x, y - 1 }, { x, y + 1 } };
+		for (const auto& n : neighbours)
+		{
+			if (n[0] < 0 || n[1] < 0 || n[0] >= width || n[1] >= height) continue;
+
+			int other = n[1] * width + n[0];
+			if (blocked[other] || flows[other].distance >= 0) continue;
+
+			flows[other].distance = next;
+			openCells.push_back(other);
+		}
+	}
+
+	// directions: towards the closest of the 8 neighbours. in open ground a diagonal neighbour is two
+	// bfs steps closer, so paths go diagonal there and straight along walls
+	const float diagonal = 0.70710678f;
+	const int offsets[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 } };
+
+	for (int cell : openCells)
+	{
+		if (cell == goalCell) continue;
+
+		int x = cell % width;
+		int y = cell / width;
+		int32_t best = flows[cell].distance;
+		int bestOffset = -1;
+
+		for (int o = 0; o < 8; ++o)
+		{
+			int nx = x + offsets[o][0];
+			int ny = y + offsets[o][1];
+			if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+
+			int32_t distance = flows[ny * width + nx].distance;
+			if (distance < 0) continue;
+
+			// no corner cutting
+			if (o >= 4 && (blocked[y * width + nx] || blocked[ny * width + x])) continue;
+
+			if (distance < best)
+			{
+				best = distance;
+				bestOffset = o;
+			}
+		}
+
+		if (bestOffset < 0) continue; // can't happen for a bfs-reached cell, but stay safe
+
+		float scale = bestOffset >= 4 ? diagonal : 1.0f;
+		flows[cell].dirX = offsets[bestOffset][0] * scale;
+		flows[cell].dirY = offsets[bestOffset][1] * scale;
+	}
+}
+
+Vector2 FlowField::Slide(Vector2 from, Vector2 to) const
+{
+	if (wallCount == 0 || !IsBlockedAt(to) || IsBlockedAt(from)) return to;
+
+	if (!IsBlockedAt({ to.x, from.y })) return { to.x, from.y };
+	if (!IsBlockedAt({ from.x, to.y })) return { from.x, to.y };
+	return from;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// grid of "which way to walk" towards one goal, shared by every enemy chasing it.
+// a breadth-first search from the goal cell fills in each cell's step distance, then every cell points
+// at its closest neighbour (diagonals only when both sides are open, so nobody cuts a wall corner).
+// enemies read their direction in O(1) instead of each running its own path search.
+// the grid starts at the world origin, everything outside it counts as open and unpathed.
+class FlowField {
+public:
+	FlowField(float cellSize, int width, int height);
+
+	int GetWidth() const { return width; }
+	int GetHeight() const { return height; }
+	float GetCellSize() const { return cellSize; }
+
+	// walls, the field is rebuilt on the next Update after a change
+	void SetBlocked(int cellX, int cellY, bool blocked);
+	void SetBlockedRect(Rectangle rect, bool blocked = true);   // every cell the rect touches
+	void ClearWalls();
+	bool IsBlocked(int cellX, int cellY) const;
+	bool IsBlockedAt(Vector2 position) const;
+	bool HasWalls() const { return wallCount > 0; }
+
+	// rebuilds only if the goal moved to another cell or the walls changed, returns whether it did
+	bool Update(Vector2 goal);
+	void Rebuild(Vector2 goal);
+
+	// unit direction to walk from position. false when there is no path to follow: outside the grid,
+	// inside a wall, cut off from the goal, or already in the goal's cell (steer straight at it then)
+	bool Sample(Vector2 position, Vector2& direction) const
+	{
+		int cellX = static_cast<int>(position.x / cellSize);
+		int cellY = static_cast<int>(position.y / cellSize);
+		if (position.x < 0 || position.y < 0 || cellX >= width || cellY >= height) return false;
+
+		const Flow& flow = flows[cellY * width + cellX];
+		if (flow.distance <= 0) return false;
+
+		direction = { flow.dirX, flow.dirY };
+		return true;
+	}
+
+	// -1 unreachable, 0 goal cell
+	int32_t GetDistance(int cellX, int cellY) const { return flows[cellY * width + cellX].distance; }
+
+	// moves from -> to unless that ends in a wall, then tries sliding along x or y only.
+	// something that already stands in a wall moves freely so it can get out
+	Vector2 Slide(Vector2 from, Vector2 to) const;
+
+private:
+	struct Flow {
+		float dirX;
+		float dirY;
+		int32_t distance;
+	};
+
+	float cellSize;
+	int width;
+	int height;
+
+	std::vector<uint8_t> blocked;
+	size_t wallCount;
+	bool wallsChanged;
+
+	std::vector<Flow> flows;
+	std::vector<int32_t> openCells;   // bfs queue, kept around between rebuilds
+	int goalCell;                     // -1 when the goal is outside the grid or in a wall
+	bool built;
+};
+
+#endif // FLOWFIELD_H
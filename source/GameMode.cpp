@@ -1,45 +1,552 @@
 #include "GameMode.h"
 #include "Actor.h"
+#include "JobSystem.h"
+#include "EcsSystems.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 GameMode::GameMode()
-	: gameTime(0)
-	, isPaused(false) {
+	: activeActorCount(0)
+	, enemySwarm(this)
+	, camera()
+	, cameraBounds{ 0, 0, 800, 600 }
+	, cullingEnabled(true)
+	, cullStats()
+	, flowField(20.0f, 40, 30) // 800x600
+	, isRecording(false)
+	, replay(nullptr)
+	, replayTick(0)
+	, jobSystem(std::make_unique<JobSystem>())
+	, worldSeed(0)
+	, spawnSerial(0)
+	, gameTime(0)
+	, isPaused(false)
+	, fixedDeltaTime(1.0f / 60.0f)
+	, accumulator(0)
+	, interpolationAlpha(1.0f)
+	, maxCatchUpSteps(5)
+	, tickCount(0) {
+	handleInputPhase = profiler.AddPhase("HandleInput");
+	updatePhase = profiler.AddPhase("Update");
+	flowFieldPhase = profiler.AddPhase("FlowField");
+	aiThinkPhase = profiler.AddPhase("AI Think");
+	tickPhaseOfType.fill(SIZE_MAX);
+
+	// actors first, then the swarm. both lists can shrink between batches, so clamp to the current size
+	aiScheduler.AddSource([this] { return activeActorCount; }, [this](size_t begin, size_t end) {
+		end = std::min(end, activeActorCount);
+		for (size_t i = begin; i < end; ++i) {
+			if (actors[i]->IsActive()) actors[i]->Think();
+		}
+	});
+	aiScheduler.AddSource([this] { return enemySwarm.Size(); }, [this](size_t begin, size_t end) {
+		enemySwarm.Think(begin, end);
+	});
+	swarmTickPhase = profiler.AddPhase("Tick EnemySwarm");
+	ecsPhase = profiler.AddPhase("ECS Systems");
+	timersPhase = profiler.AddPhase("Timers");
+	drawPhase = profiler.AddPhase("Draw");
+
+	SetWorldSeed(0);
+	SetViewportSize(800, 600);
+	camera.target = { 400, 300 };
+	camera.zoom = 1.0f;
 }
 
 GameMode::~GameMode() {  // FIXED: GameMOde -> GameMode
+	DestroyAllActors();
+}
+
+void GameMode::RegisterActor(Actor* actor, size_t typeId) {
+	uint32_t slotIndex;
+	if (!freeActorSlots.empty()) {
+		slotIndex = freeActorSlots.back();
+		freeActorSlots.pop_back();
+	}
+	else {
+		slotIndex = static_cast<uint32_t>(actorSlots.size());
+		actorSlots.push_back({ nullptr, 1, Entity() });
+	}
+
+	ActorSlot& slot = actorSlots[slotIndex];
+	slot.actor = actor;
+	slot.entity = world.Create(ActorLink{ actor });
+
+	actor->gameMode = this;
+	actor->handle = { slotIndex, slot.generation };
+	actor->rng.Seed(worldSeed, kRngStreamFirstActor + spawnSerial++);
+	actor->typeId = typeId;
+	actor->denseIndex = actors.size();
+	actors.push_back(actor);
+
+	actorGrid.Insert(slotIndex, actor->GetPosition(), static_cast<uint32_t>(typeId));
+
+	if (tickPhaseOfType[typeId] == SIZE_MAX) {
+		tickPhaseOfType[typeId] = profiler.AddPhase("Tick " + actor->GetName());
+	}
+
+	// new actors start active, move it to the end of the active range
+	if (actor->IsActive()) {
+		SwapActors(actor->denseIndex, activeActorCount);
+		++activeActorCount;
+		actorPools[typeId]->AddActive(actor);
+	}
+}
+
+void GameMode::FinishSpawning(Actor* actor) {
+	// BeginPlay usually moves the actor (random spawn points), start it off where it really is
+	actor->SavePreviousState();
+	actorGrid.Move(actor->handle.index, actor->GetPosition());
+}
+
+void GameMode::DestroyActor(Actor* actor) {
+	if (!actor || actor->gameMode != this) return;
+
+	std::lock_guard<std::mutex> lock(pendingMutex);
+	if (actor->pendingDestroy) return;
+
+	actor->pendingDestroy = true;
+	pendingDestroy.push_back(actor);
+}
+
+void GameMode::DestroyActor(ActorHandle handle) {
+	DestroyActor(ResolveActor(handle));
+}
+
+void GameMode::QueueActiveChange(Actor* actor) {
+	std::lock_guard<std::mutex> lock(pendingMutex);
+	pendingActiveChanges.push_back(actor);
+}
+
+void GameMode::SwapActors(size_t a, size_t b) {
+	if (a == b) return;
+
+	std::swap(actors[a], actors[b]);
+	actors[a]->denseIndex = a;
+	actors[b]->denseIndex = b;
+}
+
+void GameMode::RemoveActorAt(size_t index) {
+	// keep the active range packed: fill the hole from the end of the active range first...
+	if (index < activeActorCount) {
+		actorPools[actors[index]->typeId]->RemoveActive(actors[index]);
+		--activeActorCount;
+		SwapActors(index, activeActorCount);
+		index = activeActorCount;
+	}
+
+	// ...then from the end of the whole list
+	SwapActors(index, actors.size() - 1);
+	actors.pop_back();
+}
+
+void GameMode::FlushPendingActorChanges() {
+	// only ever called between ticks, the lock is for form's sake
+	std::lock_guard<std::mutex> lock(pendingMutex);
+
+	// active changes first, the list may mention actors that are about to be destroyed
+	for (Actor* actor : pendingActiveChanges) {
+		if (actor->pendingDestroy) continue;
+
+		bool inActiveRange = actor->denseIndex < activeActorCount;
+		if (actor->IsActive() && !inActiveRange) {
+			SwapActors(actor->denseIndex, activeActorCount);
+			++activeActorCount;
+			actorPools[actor->typeId]->AddActive(actor);
+		}
+		else if (!actor->IsActive() && inActiveRange) {
+			actorPools[actor->typeId]->RemoveActive(actor);
+			--activeActorCount;
+			SwapActors(actor->denseIndex, activeActorCount);
+		}
+	}
+	pendingActiveChanges.clear();
+
+	for (Actor* actor : pendingDestroy) {
+		RemoveActorAt(actor->denseIndex);
+		actorGrid.Remove(actor->handle.index);
+
+		ActorSlot& slot = actorSlots[actor->handle.index];
+		slot.actor = nullptr;
+		world.Destroy(slot.entity);
+		++slot.generation;
+		if (slot.generation == 0) slot.generation = 1; // 0 means "never set"
+		freeActorSlots.push_back(actor->handle.index);
+
+		actorPools[actor->typeId]->Free(actor);
+	}
+	pendingDestroy.clear();
+}
+
+void GameMode::DestroyAllActors() {
+	// memory belongs to the arena, only the destructors need running.
+	// slots stay around with a new generation so old handles stay stale
+	for (Actor* actor : actors) {
+		ActorSlot& slot = actorSlots[actor->handle.index];
+		slot.actor = nullptr;
+		world.Destroy(slot.entity);
+		++slot.generation;
+		if (slot.generation == 0) slot.generation = 1;
+		freeActorSlots.push_back(actor->handle.index);
+
+		actor->~Actor();
+	}
 	actors.clear();
+	activeActorCount = 0;
+	actorGrid.Clear();
+
+	{
+		std::lock_guard<std::mutex> lock(pendingMutex);
+		pendingDestroy.clear();
+		pendingActiveChanges.clear();
+	}
+
+	for (auto& pool : actorPools) {
+		if (pool) pool->Reset();
+	}
+	levelArena.Reset();
 }
 
 void GameMode::HandleInput() {
+	ScopedTimer timer(profiler, handleInputPhase);
+
+	// the only place the keyboard is read, the frame's ticks all see this
+	liveInput = InputState::Sample();
+
+	if (IsKeyPressed(KEY_F3)) {
+		profiler.SetOverlayVisible(!profiler.IsOverlayVisible());
+	}
+
 	if (IsKeyPressed(KEY_P)) {  // FIXED: isKeyPressed -> IsKeyPressed
 		isPaused = !isPaused;
 	}
+
+	if (IsKeyPressed(KEY_F4)) {
+		cullingEnabled = !cullingEnabled;
+	}
+
+	if (IsKeyPressed(KEY_EQUAL)) SetCameraZoom(camera.zoom * 1.25f);
+	if (IsKeyPressed(KEY_MINUS)) SetCameraZoom(camera.zoom / 1.25f);
+}
+
+void GameMode::SetCameraFollow(Actor* target) {
+	cameraFollow = target ? target->GetHandle() : ActorHandle();
+}
+
+void GameMode::SetCameraZoom(float zoom) {
+	camera.zoom = std::min(std::max(zoom, 0.25f), 4.0f);
+}
+
+void GameMode::SetViewportSize(float width, float height) {
+	// the camera target sits in the middle of the screen
+	camera.offset = { width * 0.5f, height * 0.5f };
+}
+
+Rectangle GameMode::GetViewRect() const {
+	float width = camera.offset.x * 2.0f / camera.zoom;
+	float height = camera.offset.y * 2.0f / camera.zoom;
+	return { camera.target.x - width * 0.5f, camera.target.y - height * 0.5f, width, height };
+}
+
+void GameMode::UpdateWorldCamera() {
+	if (Actor* followed = ResolveActor(cameraFollow)) {
+		camera.target = followed->GetRenderPosition();
+	}
+
+	// keep the view inside the bounds, centred on them on an axis where they are smaller than the view
+	Rectangle view = GetViewRect();
+	auto clampAxis = [](float target, float halfView, float min, float size) {
+		if (size <= halfView * 2.0f) return min + size * 0.5f;
+		return std::min(std::max(target, min + halfView), min + size - halfView);
+	};
+	camera.target.x = clampAxis(camera.target.x, view.width * 0.5f, cameraBounds.x, cameraBounds.width);
+	camera.target.y = clampAxis(camera.target.y, view.height * 0.5f, cameraBounds.y, cameraBounds.height);
+}
+
+void GameMode::SetThreadCount(unsigned int threadCount) {
+	jobSystem = std::make_unique<JobSystem>(threadCount);
+	SeedThreadRngs();
+}
+
+void GameMode::SetWorldSeed(uint64_t seed) {
+	worldSeed = seed;
+	spawnSerial = 0;
+	enemySwarm.SetRandomSeed(seed);
+	SeedThreadRngs();
+}
+
+TimerHandle GameMode::SetTimer(std::function<void()> callback, float delay, bool looping) {
+	// 1/60 s is one tick, not two. anything <= 0 fires next tick
+	uint64_t ticks = delay > 0 ? static_cast<uint64_t>(std::ceil(delay / fixedDeltaTime - 0.001f)) : 0;
+	return timers.Set(std::move(callback), ticks, looping ? (ticks > 0 ? ticks : 1) : 0);
+}
+
+void GameMode::StartRecording(const LevelDescription& level, uint32_t thinksPerTick) {
+	recording.Begin(worldSeed, 1.0f / fixedDeltaTime, level, thinksPerTick);
+	aiScheduler.SetThinkLimit(thinksPerTick > 0 ? thinksPerTick : SIZE_MAX);
+	isRecording = true;
+}
+
+void GameMode::StopRecording() {
+	isRecording = false;
+	if (!replay) aiScheduler.SetThinkLimit(0);
+}
+
+void GameMode::StartReplay(const InputRecording& newReplay) {
+	replay = &newReplay;
+	replayTick = 0;
+	aiScheduler.SetThinkLimit(replay->GetThinksPerTick() > 0 ? replay->GetThinksPerTick() : SIZE_MAX);
+}
+
+void GameMode::StopReplay() {
+	replay = nullptr;
+	if (!isRecording) aiScheduler.SetThinkLimit(0);
+}
+
+void GameMode::SeedThreadRngs() {
+	threadRngs.resize(jobSystem->GetThreadCount());
+	for (size_t i = 0; i < threadRngs.size(); ++i) {
+		threadRngs[i].rng.Seed(worldSeed, kRngStreamFirstThread + i);
+	}
+}
+
+unsigned int GameMode::GetThreadCount() const {
+	return jobSystem->GetThreadCount();
+}
+
+void GameMode::SetPathTarget(Actor* target) {
+	pathTarget = target ? target->GetHandle() : ActorHandle();
+}
+
+void GameMode::SetTickLod(Actor* focus, float every2ndBeyond, float every8thBeyond) {
+	lodFocus = focus ? focus->GetHandle() : ActorHandle();
+	tickLod.every2ndBeyond = every2ndBeyond;
+	tickLod.every8thBeyond = every8thBeyond;
+}
+
+void GameMode::SetTickRate(float ticksPerSecond) {
+	if (ticksPerSecond > 0) fixedDeltaTime = 1.0f / ticksPerSecond;
+}
+
+int GameMode::Advance(float frameTime) {
+	// nothing moves while paused, don't bank the time either
+	if (isPaused) {
+		accumulator = 0;
+		return 0;
+	}
+
+	accumulator += frameTime;
+
+	int steps = 0;
+	while (accumulator >= fixedDeltaTime && steps < maxCatchUpSteps) {
+		Update(fixedDeltaTime);
+		accumulator -= fixedDeltaTime;
+		++steps;
+	}
+
+	// too far behind (breakpoint, window drag, hitch): run slow for a frame instead of spiralling
+	if (accumulator >= fixedDeltaTime) {
+		accumulator = 0;
+	}
+
+	interpolationAlpha = accumulator / fixedDeltaTime;
+	return steps;
 }
 
 void GameMode::Update(float deltaTime) {
 	if (isPaused) return;
 
+	ScopedTimer timer(profiler, updatePhase);
+
 	gameTime += deltaTime;
 
-	for (auto& actor : actors) {
-		if (actor->IsActive()) {
-			actor->Tick(deltaTime);
+	// picks up SetActive/DestroyActor calls made between frames
+	FlushPendingActorChanges();
+
+	input = replay ? replay->GetTick(replayTick++) : liveInput;
+	if (isRecording) recording.Push(input);
+
+	// read previous / write next: snapshot everyone's state first, then actors tick concurrently.
+	// a Tick may only write its own actor and reads other actors through GetPreviousPosition(),
+	// which nobody writes until the next snapshot. spawning from Tick is not allowed, DestroyActor
+	// and SetActive are fine since they only take effect at the end of the frame.
+	for (Actor* actor : actors) {
+		actor->SavePreviousState();
+	}
+
+	// one path search for everybody, from where the target starts this tick
+	if (Actor* target = ResolveActor(pathTarget)) {
+		ScopedTimer flowTimer(profiler, flowFieldPhase);
+		flowField.Update(target->GetPreviousPosition());
+	}
+
+	{
+		ScopedTimer thinkTimer(profiler, aiThinkPhase);
+		aiScheduler.Run();
+	}
+
+	Actor* focus = ResolveActor(lodFocus);
+	tickLod.enabled = focus != nullptr;
+	tickLod.focus = focus ? focus->GetPreviousPosition() : Vector2{ 0, 0 };
+	tickLod.tick = tickCount++;
+
+	TickActors(deltaTime);
+
+	{
+		ScopedTimer swarmTimer(profiler, swarmTickPhase);
+		enemySwarm.Tick(deltaTime, jobSystem.get(), &tickLod);
+	}
+
+	{
+		ScopedTimer ecsTimer(profiler, ecsPhase);
+		RunEcsSystems(world, ecsState, *this, deltaTime);
+	}
+
+	SyncActorGrid();
+	ResolveContacts(deltaTime);
+
+	{
+		ScopedTimer timersTimer(profiler, timersPhase);
+		timers.Tick();
+	}
+
+	FlushPendingActorChanges();
+}
+
+void GameMode::TickActors(float deltaTime) {
+	for (size_t typeId = 0; typeId < actorPools.size(); ++typeId) {
+		ActorPoolBase* pool = actorPools[typeId].get();
+		if (!pool || pool->GetActiveCount() == 0) continue;
+
+		ScopedTimer timer(profiler, tickPhaseOfType[typeId]);
+		pool->TickAll(*jobSystem, deltaTime);
+	}
+}
+
+void GameMode::DrawActors(RenderCommandList& commands) {
+	for (const std::unique_ptr<ActorPoolBase>& pool : actorPools) {
+		if (pool && pool->GetActiveCount() > 0) pool->DrawAll(commands);
+	}
+}
+
+size_t GameMode::DrawVisibleActors(RenderCommandList& commands, Rectangle view) {
+	for (std::vector<Actor*>& bucket : visibleByType) bucket.clear();
+
+	actorGrid.QueryRect(view, [this](uint32_t id, Vector2) {
+		Actor* actor = actorSlots[id].actor;
+		if (actor->IsActive()) visibleByType[actor->typeId].push_back(actor);
+	});
+
+	size_t visible = 0;
+	for (size_t typeId = 0; typeId < visibleByType.size(); ++typeId) {
+		std::vector<Actor*>& bucket = visibleByType[typeId];
+		if (bucket.empty()) continue;
+
+		// the grid hands them out cell by cell, list order keeps the overlap order the same as DrawActors
+		std::sort(bucket.begin(), bucket.end(), [](const Actor* a, const Actor* b) { return a->denseIndex < b->denseIndex; });
+		actorPools[typeId]->DrawVisible(commands, bucket);
+		visible += bucket.size();
+	}
+	return visible;
+}
+
+void GameMode::SyncActorGrid() {
+	// Move is a no-op bucket-wise unless the actor changed cell
+	for (Actor* actor : actors) {
+		actorGrid.Move(actor->handle.index, actor->GetPosition());
+	}
+}
+
+void GameMode::ResolveContacts(float deltaTime) {
+	// only the few actors that take contact damage (the player) query, so this stays linear
+	for (size_t i = 0; i < activeActorCount; ++i) {
+		Actor* victim = actors[i];
+		if (!victim->TakesContactDamage()) continue;
+
+		Vector2 center = victim->GetPosition();
+		float radius = victim->GetCollisionRadius();
+		float damagePerSecond = 0;
+
+		actorGrid.QueryRadius(center, radius + kMaxCollisionRadius, [&](uint32_t id, Vector2 otherPos) {
+			Actor* other = actorSlots[id].actor;
+			if (other == victim || !other->IsActive()) return;
+
+			float reach = radius + other->GetCollisionRadius();
+			float dx = otherPos.x - center.x;
+			float dy = otherPos.y - center.y;
+			if (dx * dx + dy * dy <= reach * reach) {
+				damagePerSecond += other->GetContactDamage();
+			}
+		});
+
+		damagePerSecond += enemySwarm.GetContactDamageAt(center, radius);
+
+		if (damagePerSecond > 0) {
+			victim->TakeDamage(damagePerSecond * deltaTime);
 		}
 	}
 }
 
-void GameMode::Draw() {
-	for (auto& actor : actors) {
-		if (actor->IsActive()) {
-			actor->Draw();
+void GameMode::Draw(RenderCommandList& commands) {
+	ScopedTimer timer(profiler, drawPhase);
+
+	UpdateWorldCamera();
+
+	Rectangle view = GetViewRect();
+	view = { view.x - kCullMargin, view.y - kCullMargin, view.width + kCullMargin * 2.0f, view.height + kCullMargin * 2.0f };
+
+	commands.Clear();
+	commands.SetCamera(camera);
+
+	if (flowField.HasWalls()) {
+		// only the cells in view, walls don't move so there's nothing to pad for
+		float cellSize = flowField.GetCellSize();
+		int minX = 0, minY = 0, maxX = flowField.GetWidth() - 1, maxY = flowField.GetHeight() - 1;
+		if (cullingEnabled) {
+			minX = std::max(minX, static_cast<int>(std::floor(view.x / cellSize)));
+			minY = std::max(minY, static_cast<int>(std::floor(view.y / cellSize)));
+			maxX = std::min(maxX, static_cast<int>(std::floor((view.x + view.width) / cellSize)));
+			maxY = std::min(maxY, static_cast<int>(std::floor((view.y + view.height) / cellSize)));
+		}
+		for (int y = minY; y <= maxY; ++y) {
+			for (int x = minX; x <= maxX; ++x) {
+				if (flowField.IsBlocked(x, y)) commands.PushRect(x * cellSize, y * cellSize, cellSize, cellSize, DARKGRAY);
+			}
 		}
 	}
 
+	cullStats.totalActors = activeActorCount;
+	cullStats.totalSwarm = enemySwarm.Size();
+
+	EcsDrawCounts entities;
+	if (cullingEnabled) {
+		cullStats.visibleActors = DrawVisibleActors(commands, view);
+		cullStats.visibleSwarm = enemySwarm.DrawVisible(commands, interpolationAlpha, view);
+		entities = DrawEcsEntities(world, commands, interpolationAlpha, &view);
+	}
+	else {
+		DrawActors(commands);
+		enemySwarm.Draw(commands, interpolationAlpha);
+		entities = DrawEcsEntities(world, commands, interpolationAlpha);
+		cullStats.visibleActors = cullStats.totalActors;
+		cullStats.visibleSwarm = cullStats.totalSwarm;
+	}
+	cullStats.visibleEntities = entities.visible;
+	cullStats.totalEntities = entities.total;
+
+	commands.BeginScreenSpace();
 	if (isPaused) {
-		DrawText("PAUSED", 350, 280, 40, RED);
+		commands.PushText("PAUSED", 350, 280, 40, RED);
 	}
 }
 
-void GameMode::LoadLevel(const char* levelName) {
-	actors.clear();
+void GameMode::LoadLevel(const char* /*levelName*/) {
+	DestroyAllActors();
+	world.Clear();
+	timers.ClearAll();
+	enemySwarm.Clear();
+	flowField.ClearWalls();
+	pathTarget = ActorHandle();
+	lodFocus = ActorHandle();
 }
\ No newline at end of file
@@ -3,8 +3,26 @@
 #define GAMEMODE_H
 
 #include "raylib.h"
+#include "EnemySwarm.h"
+#include "LevelArena.h"
+#include "ActorPool.h"
+#include "ActorHandle.h"
+#include "SpatialGrid.h"
+#include "RenderCommands.h"
+#include "Profiler.h"
+#include "FlowField.h"
+#include "AIScheduler.h"
+#include "EntityWorld.h"
+#include "EcsSystems.h"
+#include "Random.h"
+#include "InputRecording.h"
+#include "TimerManager.h"
+#include "JobSystem.h"
+#include <array>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <functional>
 #include <type_traits>
 
 
@@ -18,31 +36,327 @@ public:
 	// main loop functions
 	virtual void HandleInput();
 	virtual void Update(float deltaTime);
-	virtual void Draw();
+	// records the frame into commands (cleared first): the world through the camera, then the pause
+	// text in screen space. doesn't touch raylib, so it can run off the main thread (see RenderPipeline)
+	// and something else (BatchRenderer) submits the list
+	virtual void Draw(RenderCommandList& commands);
+
+	// fixed timestep: feed the real frame time, runs as many Update(fixed dt) steps as fit (at most
+	// maxCatchUpSteps, the rest of a long stall is dropped) and keeps the remainder for next frame.
+	// returns the number of steps run. Draw interpolates by what is left over
+	int Advance(float frameTime);
+	void SetTickRate(float ticksPerSecond);
+	float GetFixedDeltaTime() const { return fixedDeltaTime; }
+	void SetMaxCatchUpSteps(int steps) { maxCatchUpSteps = steps > 0 ? steps : 1; }
+
+	// 0 = previous tick, 1 = current tick. stays 1 when Update is called directly
+	float GetInterpolationAlpha() const { return interpolationAlpha; }
+
+	// this tick's input, the keyboard as HandleInput sampled it or taken from the replay. gameplay reads
+	// this, never IsKeyDown, so recordings replay exactly and Update can run off the main thread
+	const InputState& GetInput() const { return input; }
+
+	// records the input of every tick from the next Update on, along with the current world seed, tick
+	// rate and level (the one just built from it, so a replay can build the same one first). while
+	// recording, the AIScheduler thinks thinksPerTick agents a tick (0 = all) instead of going by its
+	// time budget, and the recording keeps that count for the replay
+	void StartRecording(const LevelDescription& level, uint32_t thinksPerTick = 0);
+	void StopRecording();
+	const InputRecording& GetRecording() const { return recording; }
+
+	// input comes from replay (not copied, keep it alive) instead of the keyboard, its tick 0 being the
+	// next Update. set its world seed and tick rate and build its level before starting it.
+	// the AIScheduler thinks as many agents per tick as it did when recorded
+	void StartReplay(const InputRecording& replay);
+	void StopReplay();
+	bool IsReplayFinished() const { return replay && replayTick >= replay->GetTickCount(); }
+
+	// threads used to tick actors and the swarm (including the game thread), 0 = all cores
+	void SetThreadCount(unsigned int threadCount);
+	unsigned int GetThreadCount() const;
+	JobSystem& GetJobSystem() { return *jobSystem; }
+
+	// every random number of the game comes from this seed (see Random.h): actors get a stream each in
+	// spawn order, the swarm one, each job system thread one. set it before spawning, it restarts the
+	// spawn order, so the same seed and spawns give the same game
+	void SetWorldSeed(uint64_t seed);
+	uint64_t GetWorldSeed() const { return worldSeed; }
+	Rng CreateRng(uint64_t stream) const { return Rng(worldSeed, stream); }
+
+	// the calling thread's stream, for effects where which thread draws what doesn't matter. not
+	// reproducible under work stealing, gameplay that must replay uses the actor's own GetRandom()
+	Rng& GetThreadRng() { return threadRngs[JobSystem::GetCurrentThreadIndex()].rng; }
 
 	// Actor Management (great value unreal spawnactor)
+	// actors are constructed into per-type pools carved from the level arena, no heap allocation per spawn
 	template<typename T>
 	T* SpawnActor(Vector2 location)
 	{
 		static_assert(std::is_base_of<Actor, T>::value, "T must be derived from Actor");
 
-		auto actor = std::make_unique<T>();
+		T* actor = GetActorPool<T>().Allocate();
 		actor->SetPosition(location);
 
-		T* actorPtr = actor.get();
-		actors.push_back(std::move(actor));
+		RegisterActor(actor, ActorTypeId<T>());
 
-		actorPtr->BeginPlay();
-		return actorPtr;
+		actor->BeginPlay();
+		FinishSpawning(actor);
+		return actor;
 	}
 
+	// a whole wave at once: storage for all of them is carved in one piece, the lists are grown once,
+	// BeginPlay runs as one batch through T::BeginPlayAll (on the job system when T::kParallelBeginPlay),
+	// then initializer(T&, size_t index) runs on each, so positions it sets win over the ones BeginPlay
+	// picks (Enemy spawns at a random spot). the returned handles are valid until the next SpawnActors call
+	template<typename T, typename Initializer>
+	ActorHandleRange SpawnActors(size_t count, Initializer&& initializer)
+	{
+		static_assert(std::is_base_of<Actor, T>::value, "T must be derived from Actor");
+
+		ActorPool<T>& pool = GetActorPool<T>();
+		ActorSpan<T> wave = pool.AllocateRun(count);
+
+		const size_t typeId = ActorTypeId<T>();
+		actors.reserve(actors.size() + count);
+		actorSlots.reserve(actorSlots.size() + count);
+		pool.ReserveActive(count);
+		spawnedHandles.resize(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			RegisterActor(wave.data[i], typeId);
+			spawnedHandles[i] = wave.data[i]->GetHandle();
+		}
+
+		if (T::kParallelBeginPlay)
+		{
+			jobSystem->ParallelFor(0, count, 256, [wave](size_t begin, size_t end) {
+				T::BeginPlayAll(ActorSpan<T>{ wave.data + begin, end - begin });
+			});
+		}
+		else
+		{
+			T::BeginPlayAll(wave);
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			initializer(*wave.data[i], i);
+			FinishSpawning(wave.data[i]);
+		}
+
+		return ActorHandleRange{ spawnedHandles.data(), count };
+	}
+
+	// removal is deferred to the end of the frame (safe to call from Tick), the slot's generation is then
+	// bumped so every handle to the actor goes stale and its memory goes back to the pool
+	void DestroyActor(Actor* actor);
+	void DestroyActor(ActorHandle handle);
+
+	// nullptr once the actor has been destroyed (or the handle was never set)
+	Actor* ResolveActor(ActorHandle handle) const
+	{
+		if (handle.index >= actorSlots.size()) return nullptr;
+		const ActorSlot& slot = actorSlots[handle.index];
+		return slot.generation == handle.generation ? slot.actor : nullptr;
+	}
+
+	// every spawned actor by handle index, tagged with its type id. synced after the tick phase,
+	// so during Tick it holds start-of-tick positions and can be queried from any thread
+	const SpatialGrid& GetActorGrid() const { return actorGrid; }
+
+	// world camera, Draw renders through it. follows the actor's render position when one is set (else
+	// stays where SetCameraTarget put it) and is kept inside the camera bounds, the flow field's area
+	// unless set. zoom 1 shows viewport size world units, +/- zoom in the game. view only, replays
+	// don't care
+	void SetCameraFollow(Actor* target);
+	void SetCameraTarget(Vector2 target) { camera.target = target; }
+	void SetCameraZoom(float zoom);
+	float GetCameraZoom() const { return camera.zoom; }
+	void SetCameraBounds(Rectangle bounds) { cameraBounds = bounds; }
+	// the level's area: the camera stays inside it and the player can't walk out of it
+	Rectangle GetCameraBounds() const { return cameraBounds; }
+	void SetViewportSize(float width, float height);
+	const Camera2D& GetCamera() const { return camera; }
+	// the world area on screen after the last Draw
+	Rectangle GetViewRect() const;
+
+	// visible / total of each kind in the last Draw
+	struct CullStats {
+		size_t visibleActors;
+		size_t totalActors;
+		size_t visibleSwarm;
+		size_t totalSwarm;
+		size_t visibleEntities;
+		size_t totalEntities;
+
+		size_t GetVisible() const { return visibleActors + visibleSwarm + visibleEntities; }
+		size_t GetTotal() const { return totalActors + totalSwarm + totalEntities; }
+	};
+
+	// Draw only pushes what is inside the view: actors and swarm enemies come out of their spatial grids,
+	// entities are tested one by one. on by default, F4 toggles it
+	void SetCullingEnabled(bool enabled) { cullingEnabled = enabled; }
+	bool IsCullingEnabled() const { return cullingEnabled; }
+	const CullStats& GetCullStats() const { return cullStats; }
+
+	// walls of the level plus the directions towards the path target, rebuilt at the start of a tick
+	// whenever the target changes cell. enemies chasing the path target follow it, others seek straight
+	FlowField& GetFlowField() { return flowField; }
+	const FlowField& GetFlowField() const { return flowField; }
+	void SetPathTarget(Actor* target);
+	ActorHandle GetPathTarget() const { return pathTarget; }
+
+	// tick lod: actors and swarm enemies further than every2ndBeyond from focus tick every 2nd tick,
+	// further than every8thBeyond every 8th, with the skipped time added to their next tick (see TickLod)
+	void SetTickLod(Actor* focus, float every2ndBeyond, float every8thBeyond);
+	void DisableTickLod() { lodFocus = ActorHandle(); }
+	const TickLod& GetTickLod() const { return tickLod; }
+
+	// great value unreal timers: callback after delay seconds (rounded up to whole ticks), then every
+	// delay seconds when looping. they run on the game thread after the contacts of the tick they are due
+	// in, so they may spawn and destroy. per tick only due timers cost anything, see TimerManager
+	TimerHandle SetTimer(std::function<void()> callback, float delay, bool looping = false);
+	void ClearTimer(TimerHandle& handle) { timers.Clear(handle); }
+	bool IsTimerActive(TimerHandle handle) const { return timers.IsActive(handle); }
+	float GetTimerRemaining(TimerHandle handle) const { return timers.GetRemainingTicks(handle) * fixedDeltaTime; }
+	TimerManager& GetTimerManager() { return timers; }
+
+	// runs actor and swarm Think under a per-tick budget (SetBudgetMicroseconds), see its stats for the lag
+	AIScheduler& GetAIScheduler() { return aiScheduler; }
+
+	// HandleInput, Update, Draw and each actor class's Tick are timed in here. the owner of the
+	// frame loop adds its own phases (Render) and calls EndFrame. F3 toggles the overlay
+	Profiler& GetProfiler() { return profiler; }
+
+	// nothing is bigger than this, used to pad contact queries
+	static constexpr float kMaxCollisionRadius = 32.0f;
+	// how far outside the view something can be and still show: the biggest sprite plus its health
+	// bar, plus a tick's movement since the grids were synced
+	static constexpr float kCullMargin = kMaxCollisionRadius + 16.0f;
+
+	size_t GetActorCount() const { return actors.size(); }
+	Actor* GetActorAt(size_t index) const { return actors[index]; } // active ones first, order changes on removal
+	size_t GetActiveActorCount() const { return activeActorCount; }
+
+	// every active actor's Tick / Draw, one concrete type after the other (in type id order) through
+	// the pools' T::TickAll / T::DrawAll. Update and Draw call these
+	void TickActors(float deltaTime);
+	void DrawActors(RenderCommandList& commands);
+	// the active actors the actor grid has inside view, same type order. returns how many
+	size_t DrawVisibleActors(RenderCommandList& commands, Rectangle view);
+
+	// called by Actor::SetActive, applied with the destroys at the end of the frame
+	void QueueActiveChange(Actor* actor);
+
+	// pre-size the actor list before a big wave so push_back never reallocates mid-spawn
+	void ReserveActors(size_t count) { actors.reserve(count); actorSlots.reserve(count); }
+	const LevelArena& GetLevelArena() const { return levelArena; }
+
+	// component-based entities (EcsComponents.h), their systems run after the actor ticks (EcsSystems.h).
+	// every spawned actor also gets an entity with an ActorLink, so queries can reach legacy actors too
+	EntityWorld& GetWorld() { return world; }
+
+	// enemies live in the swarm rather than as actors, see EnemySwarm
+	EnemyHandle SpawnEnemy() { return enemySwarm.Spawn(); }
+	EnemySwarm& GetEnemySwarm() { return enemySwarm; }
+
 	//level transitioner ( great value OpenLevel)
 	virtual void LoadLevel(const char* levelName);
 
 protected:
-	std::vector<std::unique_ptr<Actor>> actors;
+	template<typename T>
+	ActorPool<T>& GetActorPool()
+	{
+		std::unique_ptr<ActorPoolBase>& pool = actorPools[ActorTypeId<T>()];
+		if (!pool) pool = std::make_unique<ActorPool<T>>(levelArena);
+		return static_cast<ActorPool<T>&>(*pool);
+	}
+
+	// one cache line each so threads don't share them
+	struct alignas(64) ThreadRng {
+		Rng rng;
+	};
+
+	void SeedThreadRngs();
+
+	struct ActorSlot {
+		Actor* actor;
+		uint32_t generation;
+		Entity entity; // the actor's ActorLink entity
+	};
+
+	void RegisterActor(Actor* actor, size_t typeId);
+	void FinishSpawning(Actor* actor);
+	void SyncActorGrid();
+	void UpdateWorldCamera();
+	void ResolveContacts(float deltaTime);
+	void FlushPendingActorChanges();
+	void SwapActors(size_t a, size_t b);
+	void RemoveActorAt(size_t index);
+
+	// runs every actor's destructor and rewinds the arena in one go
+	void DestroyAllActors();
+
+	LevelArena levelArena;
+	std::array<std::unique_ptr<ActorPoolBase>, kActorTypeCount> actorPools; // indexed by ActorTypeId<T>(), made on first spawn
+	std::vector<Actor*> actors;                             // owned by the pools, active ones first
+	size_t activeActorCount;                                // actors[0, activeActorCount) tick and draw
+	std::vector<ActorSlot> actorSlots;                      // indexed by ActorHandle::index
+	std::vector<uint32_t> freeActorSlots;
+	std::vector<ActorHandle> spawnedHandles;                // last SpawnActors wave
+	SpatialGrid actorGrid;
+
+	// filled from (possibly concurrent) Tick calls, drained at the end of the frame
+	std::mutex pendingMutex;
+	std::vector<Actor*> pendingDestroy;
+	std::vector<Actor*> pendingActiveChanges;
+
+	EntityWorld world;
+	EcsSystemState ecsState;
+	EnemySwarm enemySwarm;
+	Camera2D camera;
+	ActorHandle cameraFollow;
+	Rectangle cameraBounds;
+	bool cullingEnabled;
+	CullStats cullStats;
+	std::array<std::vector<Actor*>, kActorTypeCount> visibleByType; // DrawVisibleActors' buckets, indexed by type id
+	FlowField flowField;
+	ActorHandle pathTarget;
+
+	InputState input;
+	InputState liveInput;                 // keyboard at the last HandleInput
+	InputRecording recording;
+	bool isRecording;
+	const InputRecording* replay;
+	size_t replayTick;
+	AIScheduler aiScheduler;
+	TimerManager timers;
+	ActorHandle lodFocus;
+	TickLod tickLod;
+
+	Profiler profiler;
+	size_t handleInputPhase;
+	size_t updatePhase;
+	size_t swarmTickPhase;
+	size_t flowFieldPhase;
+	size_t aiThinkPhase;
+	size_t ecsPhase;
+	size_t timersPhase;
+	size_t drawPhase;
+	std::array<size_t, kActorTypeCount> tickPhaseOfType; // indexed by type id, SIZE_MAX until an actor of that type spawns
+	std::unique_ptr<JobSystem> jobSystem;
+	std::vector<ThreadRng> threadRngs;    // indexed by JobSystem::GetCurrentThreadIndex()
+	uint64_t worldSeed;
+	uint64_t spawnSerial;                 // actors spawned since the seed was set, picks their stream
 	float gameTime;
 	bool isPaused;
+
+	float fixedDeltaTime;
+	float accumulator;
+	float interpolationAlpha;
+	int maxCatchUpSteps;
+	uint64_t tickCount;
 };
 
 #endif
\ No newline at end of file
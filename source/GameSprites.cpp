@@ -0,0 +1,81 @@
+#include "GameSprites.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+	Color Scale(Color color, float factor)
+	{
+		auto channel = [factor](unsigned char value) {
+			return static_cast<unsigned char>(std::min(255.0f, value * factor));
+		};
+		return Color{ channel(color.r), channel(color.g), channel(color.b), color.a };
+	}
+
+	// filled circle, alpha from how much of the pixel is inside (one pixel wide ramp)
+	void FillDisc(SpriteImage& image, float centerX, float centerY, float radius, Color color)
+	{
+		for (int y = 0; y < image.height; ++y)
+		{
+			for (int x = 0; x < image.width; ++x)
+			{
+				float dx = x + 0.5f - centerX;
+				float dy = y + 0.5f - centerY;
+				float coverage = std::min(std::max(radius - std::sqrt(dx * dx + dy * dy) + 0.5f, 0.0f), 1.0f);
+				if (coverage <= 0) continue;
+
+				// over whatever is there already
+				Color& pixel = image.At(x, y);
+				float alpha = coverage * color.a / 255.0f;
+				pixel.r = static_cast<unsigned char>(color.r * alpha + pixel.r * (1 - alpha));
+				pixel.g = static_cast<unsigned char>(color.g * alpha + pixel.g * (1 - alpha));
+				pixel.b = static_cast<unsigned char>(color.b * alpha + pixel.b * (1 - alpha));
+				pixel.a = static_cast<unsigned char>(std::min(255.0f, alpha * 255.0f + pixel.a * (1 - alpha)));
+			}
+		}
+	}
+
+	void FillRect(SpriteImage& image, int left, int top, int width, int height, Color color)
+	{
+		for (int y = top; y < top + height; ++y)
+		{
+			for (int x = left; x < left + width; ++x) image.At(x, y) = color;
+		}
+	}
+
+	// square body with a darker frame, what Actor and Enemy used to be as plain rects
+	SpriteImage FramedSquare(int size, int frame, Color color)
+	{
+		SpriteImage image(size, size, Scale(color, 0.6f));
+		FillRect(image, frame, frame, size - frame * 2, size - frame * 2, color);
+		return image;
+	}
+
+} // namespace
+
+void AddGameSprites(TextureAtlas& atlas)
+{
+	atlas.Add("white square", SpriteImage(8, 8, WHITE));
+
+	SpriteImage disc(64, 64);
+	FillDisc(disc, 32, 32, 31.5f, WHITE);
+	atlas.Add("white disc", std::move(disc));
+
+	// blue ball with a highlight up left
+	SpriteImage player(40, 40);
+	FillDisc(player, 20, 20, 19.5f, Scale(BLUE, 0.7f));
+	FillDisc(player, 19, 19, 17.5f, BLUE);
+	FillDisc(player, 14, 13, 5.0f, Color{ 255, 255, 255, 110 });
+	atlas.Add("player", std::move(player));
+
+	// red block with eyes
+	SpriteImage enemy = FramedSquare(30, 2, RED);
+	FillRect(enemy, 7, 9, 6, 6, WHITE);
+	FillRect(enemy, 17, 9, 6, 6, WHITE);
+	FillRect(enemy, 9, 11, 3, 3, BLACK);
+	FillRect(enemy, 19, 11, 3, 3, BLACK);
+	FillRect(enemy, 8, 21, 14, 2, Scale(RED, 0.4f));
+	atlas.Add("enemy", std::move(enemy));
+
+	atlas.Add("actor", FramedSquare(20, 2, RED));
+}
@@ -0,0 +1,21 @@
+#pragma once
+#ifndef GAMESPRITES_H
+#define GAMESPRITES_H
+
+#include "TextureAtlas.h"
+
+// the game's sprites, ids fixed by the order AddGameSprites adds them in, so Draw code can use them
+// without a lookup and without holding the atlas
+enum GameSprite : SpriteId {
+	kSpriteWhiteSquare,   // tint it
+	kSpriteWhiteDisc,     // tint it, anti-aliased edge
+	kSpritePlayer,
+	kSpriteEnemy,
+	kSpriteActor,
+	kGameSpriteCount
+};
+
+// generated rather than loaded, the repo ships no art. call on an empty atlas before Build
+void AddGameSprites(TextureAtlas& atlas);
+
+#endif // GAMESPRITES_H
@@ -0,0 +1,141 @@
+#include "GoldenFrame.h"
+#include "GameMode.h"
+#include "Player.h"
+#include "Enemy.h"
+#include "DefaultLevel.h"
+#include "EcsSystems.h"
+#include "GameSprites.h"
+#include "PngFile.h"
+#include "SoftwareRenderer.h"
+#include "TextureAtlas.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+	const uint64_t kFrameSeed = 24;
+	const int kFrameTicks = 120;
+	const int kFrameWidth = 800;
+	const int kFrameHeight = 600;
+
+	// no input, the enemies close in on the player for two seconds
+	void BuildFrameScenario(GameMode& gameMode)
+	{
+		gameMode.SetTickRate(60.0f);
+		gameMode.SetWorldSeed(kFrameSeed);
+
+		Player* player = BuildDefaultLevel(gameMode);
+		gameMode.GetAIScheduler().SetBudgetMicroseconds(1e12);
+
+		gameMode.GetEnemySwarm().SpawnWave(200, player);
+		gameMode.SpawnActors<Enemy>(50, [player](Enemy& enemy, size_t) { enemy.SetTarget(player); });
+
+		EntityWorld& world = gameMode.GetWorld();
+		Rng rng = gameMode.CreateRng(kRngStreamScenario);
+		for (int i = 0; i < 50; ++i)
+		{
+			Vector2 location = { static_cast<float>(rng.RangeInt(50, 750)), static_cast<float>(rng.RangeInt(50, 550)) };
+			SpawnEnemyEntity(world, location, player->GetHandle());
+		}
+	}
+
+} // namespace
+
+int RunGoldenFrameCheck(const char* mode, const char* path, unsigned int threadCount, int tolerance)
+{
+	const bool write = std::strcmp(mode, "write") == 0;
+	if (!write && std::strcmp(mode, "check") != 0)
+	{
+		std::printf("unknown frame mode '%s' (write or check)\n", mode);
+		return 1;
+	}
+
+	std::vector<Color> golden;
+	int goldenWidth = 0;
+	int goldenHeight = 0;
+	if (!write && !ReadPng(path, golden, goldenWidth, goldenHeight))
+	{
+		std::printf("can't read golden frame %s\n", path);
+		return 1;
+	}
+
+	GameMode gameMode;
+	gameMode.SetThreadCount(threadCount);
+	gameMode.GetProfiler().SetEnabled(false);
+	BuildFrameScenario(gameMode);
+	for (int t = 0; t < kFrameTicks; ++t) gameMode.Update(gameMode.GetFixedDeltaTime());
+
+	RenderCommandList commands;
+	gameMode.Draw(commands);
+
+	TextureAtlas atlas(256);
+	AddGameSprites(atlas);
+	if (!atlas.Build())
+	{
+		std::printf("texture atlas: a sprite doesn't fit on a %dpx page\n", atlas.GetPageSize());
+		return 1;
+	}
+
+	SoftwareRenderer renderer(kFrameWidth, kFrameHeight, threadCount);
+	renderer.SetAtlas(&atlas);
+
+	auto start = std::chrono::steady_clock::now();
+	renderer.Submit(commands);
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	std::printf("golden frame: %d ticks, %zu commands, %zu primitives (%zu text skipped), threads: %u, rendered in %.3f ms\n",
+		kFrameTicks, commands.Size(), renderer.GetPrimitiveCount(), renderer.GetSkippedTextCount(), renderer.GetThreadCount(), ms);
+
+	const Color* pixels = renderer.GetPixels();
+	if (write)
+	{
+		if (!WritePng(path, pixels, kFrameWidth, kFrameHeight))
+		{
+			std::printf("can't write golden frame %s\n", path);
+			return 1;
+		}
+		std::printf("wrote %s\n", path);
+		return 0;
+	}
+
+	if (goldenWidth != kFrameWidth || goldenHeight != kFrameHeight)
+	{
+		std::printf("MISMATCH: golden frame is %dx%d, rendered %dx%d\n", goldenWidth, goldenHeight, kFrameWidth, kFrameHeight);
+		return 2;
+	}
+
+	// differing pixels red on a dimmed copy of the golden one
+	std::vector<Color> diff(golden.size());
+	size_t differing = 0;
+	size_t first = 0;
+	for (size_t i = 0; i < golden.size(); ++i)
+	{
+		const Color& a = golden[i];
+		const Color& b = pixels[i];
+		bool same = std::abs(a.r - b.r) <= tolerance && std::abs(a.g - b.g) <= tolerance
+			&& std::abs(a.b - b.b) <= tolerance && std::abs(a.a - b.a) <= tolerance;
+		if (!same && differing++ == 0) first = i;
+		diff[i] = same ? Color{ static_cast<unsigned char>(a.r / 4), static_cast<unsigned char>(a.g / 4), static_cast<unsigned char>(a.b / 4), 255 } : RED;
+	}
+
+	if (differing == 0)
+	{
+		std::printf("matches %s (tolerance %d)\n", path, tolerance);
+		return 0;
+	}
+
+	const Color& expected = golden[first];
+	const Color& actual = pixels[first];
+	std::printf("MISMATCH: %zu of %zu pixels differ (tolerance %d), first at (%zu, %zu)\n",
+		differing, golden.size(), tolerance, first % kFrameWidth, first / kFrameWidth);
+	std::printf("  expected rgba(%d, %d, %d, %d)\n", expected.r, expected.g, expected.b, expected.a);
+	std::printf("  actual   rgba(%d, %d, %d, %d)\n", actual.r, actual.g, actual.b, actual.a);
+
+	std::string diffPath = std::string(path) + ".diff.png";
+	if (WritePng(diffPath.c_str(), diff.data(), kFrameWidth, kFrameHeight)) std::printf("  wrote %s\n", diffPath.c_str());
+	return 2;
+}
@@ -0,0 +1,12 @@
+#pragma once
+#ifndef GOLDENFRAME_H
+#define GOLDENFRAME_H
+
+// headless frame check: a fixed scenario (default level, swarm, Enemy actors and ECS enemies) is run
+// for a few seconds, drawn, and rendered by the SoftwareRenderer at 800x600 with the game atlas.
+// mode "write" saves the frame as a PNG at path, "check" compares against it: a pixel differs when a
+// channel is more than tolerance apart. on a mismatch the differing pixels are written to
+// <path>.diff.png. returns 0 when it matches, 2 when it doesn't
+int RunGoldenFrameCheck(const char* mode, const char* path, unsigned int threadCount, int tolerance);
+
+#endif // GOLDENFRAME_H
@@ -0,0 +1,326 @@
+#include "GoldenTrace.h"
+#include "GameMode.h"
+#include "Actor.h"
+#include "Player.h"
+#include "Enemy.h"
+#include "DefaultLevel.h"
+#include "EcsSystems.h"
+#include "InputRecording.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+	const char kMagic[4] = { 'R', 'G', 'L', 'D' };
+	const uint32_t kVersion = 1;
+
+	// FNV-1a, 64 bit
+	void HashBytes(uint64_t& hash, const void* data, size_t size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 0x100000001B3ull;
+		}
+	}
+
+	// values within the same tolerance step hash the same, 0 = exact bits
+	int64_t Quantize(float value, float tolerance)
+	{
+		if (tolerance <= 0)
+		{
+			int32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+		return static_cast<int64_t>(std::floor(value / tolerance + 0.5f));
+	}
+
+	bool OrderBefore(const TracedState& a, const TracedState& b)
+	{
+		return a.kind != b.kind ? a.kind < b.kind : a.id < b.id;
+	}
+
+	const char* KindName(uint8_t kind)
+	{
+		switch (kind)
+		{
+		case TracedState::Actor: return "actor";
+		case TracedState::SwarmEnemy: return "swarm enemy";
+		default: return "entity";
+		}
+	}
+
+	// the scenario every build is held to. the AI budget is unlimited, a time budget would make
+	// how many enemies think per tick depend on the machine
+	const uint64_t kScenarioSeed = 19;
+
+	void BuildScenario(GameMode& gameMode, InputRecording& script, int ticks)
+	{
+		gameMode.SetTickRate(60.0f);
+		gameMode.SetWorldSeed(kScenarioSeed);
+
+		Player* player = BuildDefaultLevel(gameMode);
+		gameMode.GetAIScheduler().SetBudgetMicroseconds(1e12);
+
+		gameMode.GetEnemySwarm().SpawnWave(300, player);
+		gameMode.SpawnActors<Enemy>(100, [player](Enemy& enemy, size_t) { enemy.SetTarget(player); });
+
+		EntityWorld& world = gameMode.GetWorld();
+		Rng rng = gameMode.CreateRng(kRngStreamScenario);
+		for (int i = 0; i < 100; ++i)
+		{
+			Vector2 location = { static_cast<float>(rng.RangeInt(50, 750)), static_cast<float>(rng.RangeInt(50, 550)) };
+			Entity enemy = SpawnEnemyEntity(world, location, player->GetHandle());
+			if (i % 4 == 0) world.Add(enemy, Slow{ 0.5f, 2.0f });
+		}
+
+		// the player walks a loop: right, down, left, up, idle, 45 ticks each
+		const uint8_t pattern[] = { kInputRight, kInputDown, kInputLeft, kInputUp, 0 };
+		script.Begin(kScenarioSeed, 60.0f, LevelDescription());
+		for (int t = 0; t < ticks; ++t)
+		{
+			script.Push(InputState{ pattern[(t / 45) % 5] });
+		}
+		gameMode.StartReplay(script);
+	}
+
+} // namespace
+
+void GoldenTrace::Capture(GameMode& gameMode, std::vector<TracedState>& out)
+{
+	out.clear();
+
+	for (size_t i = 0; i < gameMode.GetActorCount(); ++i)
+	{
+		Actor* actor = gameMode.GetActorAt(i);
+		TracedState state = {};
+		state.kind = TracedState::Actor;
+		state.active = actor->IsActive();
+		state.id = actor->GetHandle().index;
+		state.x = actor->GetPosition().x;
+		state.y = actor->GetPosition().y;
+		state.health = actor->GetHealth();
+		out.push_back(state);
+	}
+
+	const EnemySwarm& swarm = gameMode.GetEnemySwarm();
+	for (size_t i = 0; i < swarm.Size(); ++i)
+	{
+		TracedState state = {};
+		state.kind = TracedState::SwarmEnemy;
+		state.active = 1;
+		state.id = swarm.GetSlotAt(i);
+		state.x = swarm.GetPositionAt(i).x;
+		state.y = swarm.GetPositionAt(i).y;
+		state.health = swarm.GetHealthAt(i);
+		out.push_back(state);
+	}
+
+	gameMode.GetWorld().ForEach<Location>([&](Entity entity, Location& location) {
+		TracedState state = {};
+		state.kind = TracedState::EcsEntity;
+		state.active = 1;
+		state.id = entity.index;
+		state.x = location.position.x;
+		state.y = location.position.y;
+		Health* health = gameMode.GetWorld().Get<Health>(entity);
+		state.health = health ? health->current : 0.0f;
+		out.push_back(state);
+	});
+
+	std::sort(out.begin(), out.end(), OrderBefore);
+}
+
+uint64_t GoldenTrace::Hash(const std::vector<TracedState>& states, float tolerance)
+{
+	uint64_t hash = 0xCBF29CE484222325ull;
+	for (const TracedState& state : states)
+	{
+		int64_t values[3] = { Quantize(state.x, tolerance), Quantize(state.y, tolerance), Quantize(state.health, tolerance) };
+		HashBytes(hash, &state.kind, sizeof(state.kind));
+		HashBytes(hash, &state.active, sizeof(state.active));
+		HashBytes(hash, &state.id, sizeof(state.id));
+		HashBytes(hash, values, sizeof(values));
+	}
+	return hash;
+}
+
+void GoldenTrace::Push(const std::vector<TracedState>& states)
+{
+	ticks.push_back({ Hash(states, hashTolerance), states });
+}
+
+GoldenTrace::Divergence GoldenTrace::Compare(const GoldenTrace& actual, float tolerance) const
+{
+	Divergence divergence = {};
+	const bool trustHashes = hashTolerance == actual.hashTolerance && hashTolerance <= tolerance;
+	const size_t tickCount = std::min(ticks.size(), actual.ticks.size());
+
+	for (size_t t = 0; t < tickCount; ++t)
+	{
+		const Tick& expectedTick = ticks[t];
+		const Tick& actualTick = actual.ticks[t];
+		if (trustHashes && expectedTick.hash == actualTick.hash) continue;
+
+		// walk both sorted lists side by side, the first actor out of tolerance (or missing on one side) wins
+		const std::vector<TracedState>& expected = expectedTick.states;
+		const std::vector<TracedState>& got = actualTick.states;
+		size_t e = 0, g = 0;
+		while (e < expected.size() || g < got.size())
+		{
+			if (g == got.size() || (e < expected.size() && OrderBefore(expected[e], got[g])))
+			{
+				return { true, t, "missing", expected[e].kind, expected[e].id, expected[e], TracedState() };
+			}
+			if (e == expected.size() || OrderBefore(got[g], expected[e]))
+			{
+				return { true, t, "extra", got[g].kind, got[g].id, TracedState(), got[g] };
+			}
+
+			const TracedState& a = expected[e];
+			const TracedState& b = got[g];
+			const char* what = nullptr;
+			if (a.active != b.active) what = "active";
+			else if (std::fabs(a.x - b.x) > tolerance || std::fabs(a.y - b.y) > tolerance) what = "position";
+			else if (std::fabs(a.health - b.health) > tolerance) what = "health";
+
+			if (what) return { true, t, what, a.kind, a.id, a, b };
+			++e;
+			++g;
+		}
+	}
+
+	if (ticks.size() != actual.ticks.size())
+	{
+		divergence = {};
+		divergence.found = true;
+		divergence.tick = tickCount;
+		divergence.what = "tick count";
+	}
+	return divergence;
+}
+
+bool GoldenTrace::Save(const char* path) const
+{
+	std::FILE* file = std::fopen(path, "wb");
+	if (!file) return false;
+
+	uint32_t tickCount = static_cast<uint32_t>(ticks.size());
+	bool ok = std::fwrite(kMagic, sizeof(kMagic), 1, file) == 1
+		&& std::fwrite(&kVersion, sizeof(kVersion), 1, file) == 1
+		&& std::fwrite(&hashTolerance, sizeof(hashTolerance), 1, file) == 1
+		&& std::fwrite(&tickCount, sizeof(tickCount), 1, file) == 1;
+
+	for (size_t t = 0; ok && t < ticks.size(); ++t)
+	{
+		uint32_t count = static_cast<uint32_t>(ticks[t].states.size());
+		ok = std::fwrite(&ticks[t].hash, sizeof(uint64_t), 1, file) == 1
+			&& std::fwrite(&count, sizeof(count), 1, file) == 1
+			&& std::fwrite(ticks[t].states.data(), sizeof(TracedState), count, file) == count;
+	}
+
+	return std::fclose(file) == 0 && ok;
+}
+
+bool GoldenTrace::Load(const char* path)
+{
+	std::FILE* file = std::fopen(path, "rb");
+	if (!file) return false;
+
+	char magic[4];
+	uint32_t version = 0;
+	uint32_t tickCount = 0;
+	bool ok = std::fread(magic, sizeof(magic), 1, file) == 1 && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0
+		&& std::fread(&version, sizeof(version), 1, file) == 1 && version == kVersion
+		&& std::fread(&hashTolerance, sizeof(hashTolerance), 1, file) == 1
+		&& std::fread(&tickCount, sizeof(tickCount), 1, file) == 1;
+
+	ticks.clear();
+	for (uint32_t t = 0; ok && t < tickCount; ++t)
+	{
+		Tick tick;
+		uint32_t count = 0;
+		ok = std::fread(&tick.hash, sizeof(uint64_t), 1, file) == 1 && std::fread(&count, sizeof(count), 1, file) == 1;
+		if (!ok) break;
+
+		tick.states.resize(count);
+		ok = std::fread(tick.states.data(), sizeof(TracedState), count, file) == count;
+		ticks.push_back(std::move(tick));
+	}
+
+	std::fclose(file);
+	if (!ok) ticks.clear();
+	return ok;
+}
+
+int RunGoldenCheck(const char* mode, const char* path, int ticks, unsigned int threadCount, float tolerance)
+{
+	const bool write = std::strcmp(mode, "write") == 0;
+	if (!write && std::strcmp(mode, "check") != 0)
+	{
+		std::printf("unknown golden mode '%s' (write or check)\n", mode);
+		return 1;
+	}
+
+	GoldenTrace golden;
+	if (!write)
+	{
+		if (!golden.Load(path))
+		{
+			std::printf("can't read golden trace %s\n", path);
+			return 1;
+		}
+		ticks = static_cast<int>(golden.GetTickCount());
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	GameMode gameMode;
+	gameMode.SetThreadCount(threadCount);
+	gameMode.GetProfiler().SetEnabled(false);
+
+	InputRecording script;
+	BuildScenario(gameMode, script, ticks);
+
+	GoldenTrace trace(golden.GetHashTolerance());
+	std::vector<TracedState> states;
+	for (int t = 0; t < ticks; ++t)
+	{
+		gameMode.Update(gameMode.GetFixedDeltaTime());
+		GoldenTrace::Capture(gameMode, states);
+		trace.Push(states);
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::printf("golden scenario: %d ticks, %zu things at the end, threads: %u, %.3f s\n",
+		ticks, states.size(), gameMode.GetThreadCount(), seconds);
+
+	if (write)
+	{
+		if (!trace.Save(path))
+		{
+			std::printf("can't write golden trace %s\n", path);
+			return 1;
+		}
+		std::printf("wrote %s\n", path);
+		return 0;
+	}
+
+	GoldenTrace::Divergence divergence = golden.Compare(trace, tolerance);
+	if (!divergence.found)
+	{
+		std::printf("matches %s (tolerance %g)\n", path, tolerance);
+		return 0;
+	}
+
+	std::printf("DIVERGED at tick %zu: %s of %s %u (tolerance %g)\n", divergence.tick, divergence.what, KindName(divergence.kind), divergence.id, tolerance);
+	std::printf("  expected pos (%.4f, %.4f) health %.4f active %d\n", divergence.expected.x, divergence.expected.y, divergence.expected.health, divergence.expected.active);
+	std::printf("  actual   pos (%.4f, %.4f) health %.4f active %d\n", divergence.actual.x, divergence.actual.y, divergence.actual.health, divergence.actual.active);
+	return 2;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#ifndef GOLDENTRACE_H
+#define GOLDENTRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class GameMode;
+
+// one simulated thing at the end of a tick. id is the actor handle index, swarm slot or entity index
+struct TracedState {
+	enum Kind : uint8_t { Actor, SwarmEnemy, EcsEntity };
+
+	uint8_t kind;
+	uint8_t active;
+	uint32_t id;
+	float x;
+	float y;
+	float health;
+};
+
+// the state of a scenario after every tick, to prove an optimized build still plays the same game.
+// each tick keeps a hash of its state (rounded to the tolerance) for the fast path and the state
+// itself, so a mismatch can name the actor that went off first
+class GoldenTrace {
+public:
+	// every actor, swarm enemy and entity with a Location, sorted by (kind, id) so the order doesn't
+	// depend on swap-and-pop history
+	static void Capture(GameMode& gameMode, std::vector<TracedState>& out);
+	static uint64_t Hash(const std::vector<TracedState>& states, float tolerance);
+
+	// the hashes are taken at hashTolerance, Compare only trusts equal hashes when that is within its own tolerance
+	explicit GoldenTrace(float hashTolerance = 0.001f) : hashTolerance(hashTolerance) {}
+
+	void Clear() { ticks.clear(); }
+	void Push(const std::vector<TracedState>& states);
+	size_t GetTickCount() const { return ticks.size(); }
+	float GetHashTolerance() const { return hashTolerance; }
+
+	struct Divergence {
+		bool found;
+		size_t tick;
+		const char* what;     // "position", "health", "active", "missing", "extra", "tick count"
+		uint8_t kind;         // which one
+		uint32_t id;
+		TracedState expected; // zero when missing on that side
+		TracedState actual;
+	};
+
+	// first tick whose state is further than tolerance from ours. tick == GetTickCount() (with found set)
+	// when the other trace is shorter or longer
+	Divergence Compare(const GoldenTrace& actual, float tolerance) const;
+
+	bool Save(const char* path) const;
+	bool Load(const char* path);
+
+private:
+	struct Tick {
+		uint64_t hash;
+		std::vector<TracedState> states;
+	};
+
+	float hashTolerance;
+	std::vector<Tick> ticks;
+};
+
+// headless scenario: the default level plus Enemy actors, swarm enemies and ECS enemies, scripted input,
+// ticks Update times. mode "write" stores the trace at path, "check" compares against it.
+// returns 0 when it matches
+int RunGoldenCheck(const char* mode, const char* path, int ticks, unsigned int threadCount, float tolerance);
+
+#endif // GOLDENTRACE_H
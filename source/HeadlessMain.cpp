@@ -0,0 +1,258 @@
+// headless runner: steps the simulation without a window so it can run on build/bench boxes
+// usage: Headless [--ticks N] [--dt seconds] [--enemies N] [--legacy-enemies] [--ecs-enemies] [--threads N] [--frame-dt seconds] [--csv path] [--walls] [--ai-budget us] [--lod near far] [--seed N] [--record path]
+//        Headless --replay path [--threads N] [--csv path]
+//        Headless --golden <write|check> path [--ticks N] [--threads N] [--tolerance t]
+//        Headless --frame <write|check> path.png [--threads N] [--tolerance channelDelta]
+//        Headless --bench <name>
+
+#include "GameMode.h"
+#include "Player.h"
+#include "DefaultLevel.h"
+#include "InputRecording.h"
+#include "GoldenTrace.h"
+#include "GoldenFrame.h"
+#include "Benchmarks.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+	int RunBenchmark(const char* name)
+	{
+		if (std::strcmp(name, "seek") == 0) return RunSeekBenchmark();
+		if (std::strcmp(name, "threads") == 0) return RunThreadScalingBenchmark();
+		if (std::strcmp(name, "spawn") == 0) return RunSpawnBenchmark();
+		if (std::strcmp(name, "batch") == 0) return RunBatchBenchmark();
+		if (std::strcmp(name, "dispatch") == 0) return RunDispatchBenchmark();
+		if (std::strcmp(name, "timers") == 0) return RunTimerBenchmark();
+		if (std::strcmp(name, "cull") == 0) return RunCullBenchmark();
+		if (std::strcmp(name, "pipeline") == 0) return RunPipelineBenchmark();
+		if (std::strcmp(name, "atlas") == 0) return RunAtlasBenchmark();
+		if (std::strcmp(name, "raster") == 0) return RunRasterBenchmark();
+		if (std::strcmp(name, "hud") == 0) return RunHudBenchmark();
+
+		std::printf("unknown benchmark '%s' (available: seek, threads, spawn, batch, dispatch, timers, cull, pipeline, atlas, raster, hud)\n", name);
+		return 1;
+	}
+
+	// one Update per recorded tick, no frame pacing, then the timings to compare builds by
+	int RunReplay(GameMode& gameMode, Player& player, const InputRecording& replay, const char* path, const char* csvPath)
+	{
+		Profiler& profiler = gameMode.GetProfiler();
+		if (csvPath && !profiler.OpenCsv(csvPath))
+		{
+			std::printf("can't write %s\n", csvPath);
+			return 1;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+
+		int ticks = 0;
+		while (!gameMode.IsReplayFinished())
+		{
+			gameMode.Update(gameMode.GetFixedDeltaTime());
+			profiler.EndFrame();
+			++ticks;
+		}
+
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		Vector2 end = player.GetPosition();
+		char thinks[16] = "all";
+		if (replay.GetThinksPerTick() > 0) std::snprintf(thinks, sizeof(thinks), "%u", replay.GetThinksPerTick());
+		std::printf("replay: %s, %d ticks (dt %.4f), seed %llu, threads: %u, AI thinks per tick: %s\n", path, ticks, gameMode.GetFixedDeltaTime(),
+			static_cast<unsigned long long>(gameMode.GetWorldSeed()), gameMode.GetThreadCount(), thinks);
+		const LevelDescription& level = replay.GetLevel();
+		const char* kinds[] = { "swarm", "actors", "entities" };
+		std::printf("level: %u enemies (%s), walls %s, lod %.0f/%.0f, ai budget %.0f us\n", level.enemyCount, kinds[level.enemyKind],
+			level.walls ? "on" : "off", level.lodNear, level.lodFar, level.aiBudgetMicroseconds);
+		std::printf("time: %.3f ms\n", seconds * 1000.0);
+		std::printf("end: player at (%.2f, %.2f) health %.2f, %zu actors, %zu entities, %zu swarm enemies\n", end.x, end.y, player.GetHealth(),
+			gameMode.GetActorCount(), gameMode.GetWorld().GetEntityCount(), gameMode.GetEnemySwarm().Size());
+
+		std::printf("\n");
+		profiler.PrintSummary();
+		return 0;
+	}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	if (argc == 3 && std::strcmp(argv[1], "--bench") == 0)
+	{
+		return RunBenchmark(argv[2]);
+	}
+
+	if (argc >= 4 && std::strcmp(argv[1], "--golden") == 0)
+	{
+		int goldenTicks = 600;
+		int goldenThreads = 0;
+		float tolerance = 0.001f;
+		for (int i = 4; i + 1 < argc; i += 2)
+		{
+			if (std::strcmp(argv[i], "--ticks") == 0) goldenTicks = std::atoi(argv[i + 1]);
+			else if (std::strcmp(argv[i], "--threads") == 0) goldenThreads = std::atoi(argv[i + 1]);
+			else if (std::strcmp(argv[i], "--tolerance") == 0) tolerance = static_cast<float>(std::atof(argv[i + 1]));
+		}
+		return RunGoldenCheck(argv[2], argv[3], goldenTicks, static_cast<unsigned int>(goldenThreads), tolerance);
+	}
+
+	if (argc >= 4 && std::strcmp(argv[1], "--frame") == 0)
+	{
+		int frameThreads = 0;
+		int tolerance = 0;
+		for (int i = 4; i + 1 < argc; i += 2)
+		{
+			if (std::strcmp(argv[i], "--threads") == 0) frameThreads = std::atoi(argv[i + 1]);
+			else if (std::strcmp(argv[i], "--tolerance") == 0) tolerance = std::atoi(argv[i + 1]);
+		}
+		return RunGoldenFrameCheck(argv[2], argv[3], static_cast<unsigned int>(frameThreads), tolerance);
+	}
+
+	int ticks = 10000;
+	float deltaTime = 1.0f / 60.0f;
+	int threadCount = 0;
+	float frameTime = 0;        // > 0: run frames of this length through the fixed-timestep Advance, dt is the tick length
+	const char* csvPath = nullptr; // per-frame profiler phases
+	uint64_t seed = 1;          // world seed, same seed same run
+	const char* recordPath = nullptr; // save this run's inputs, seed and level
+	const char* replayPath = nullptr; // play a recording back, ticks/dt/seed/level come from it
+
+	// main.cpp's level without walls or tick lod unless asked for: --enemies N, --legacy-enemies (Enemy
+	// actors instead of swarm enemies, for comparison), --ecs-enemies (enemy entities), --walls,
+	// --ai-budget us of Think per tick, --lod near far
+	LevelDescription level;
+	level.walls = false;
+	level.lodNear = 0;
+	level.lodFar = 0;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		bool hasValue = i + 1 < argc;
+		if (std::strcmp(argv[i], "--ticks") == 0 && hasValue) ticks = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--dt") == 0 && hasValue) deltaTime = static_cast<float>(std::atof(argv[++i]));
+		else if (std::strcmp(argv[i], "--enemies") == 0 && hasValue) level.enemyCount = static_cast<uint32_t>(std::atoi(argv[++i]));
+		else if (std::strcmp(argv[i], "--legacy-enemies") == 0) level.enemyKind = kLevelActorEnemies;
+		else if (std::strcmp(argv[i], "--ecs-enemies") == 0) level.enemyKind = kLevelEntityEnemies;
+		else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) threadCount = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--frame-dt") == 0 && hasValue) frameTime = static_cast<float>(std::atof(argv[++i]));
+		else if (std::strcmp(argv[i], "--csv") == 0 && hasValue) csvPath = argv[++i];
+		else if (std::strcmp(argv[i], "--walls") == 0) level.walls = true;
+		else if (std::strcmp(argv[i], "--ai-budget") == 0 && hasValue) level.aiBudgetMicroseconds = std::atof(argv[++i]);
+		else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+		else if (std::strcmp(argv[i], "--record") == 0 && hasValue) recordPath = argv[++i];
+		else if (std::strcmp(argv[i], "--replay") == 0 && hasValue) replayPath = argv[++i];
+		else if (std::strcmp(argv[i], "--lod") == 0 && i + 2 < argc)
+		{
+			level.lodNear = static_cast<float>(std::atof(argv[++i]));
+			level.lodFar = static_cast<float>(std::atof(argv[++i]));
+		}
+		else
+		{
+			std::printf("usage: %s [--ticks N] [--dt seconds] [--enemies N] [--legacy-enemies] [--ecs-enemies] [--threads N] [--frame-dt seconds] [--csv path] [--walls] [--ai-budget us] [--lod near far] [--seed N] [--record path]\n", argv[0]);
+			std::printf("       %s --replay path [--threads N] [--csv path]\n", argv[0]);
+			std::printf("       %s --golden <write|check> path [--ticks N] [--threads N] [--tolerance t]\n", argv[0]);
+			std::printf("       %s --frame <write|check> path.png [--threads N] [--tolerance channelDelta]\n", argv[0]);
+			std::printf("       %s --bench <name>\n", argv[0]);
+			return 1;
+		}
+	}
+
+	InputRecording replay;
+	if (replayPath)
+	{
+		if (!replay.Load(replayPath))
+		{
+			std::printf("can't read recording %s (missing, not a recording, or from an older build)\n", replayPath);
+			return 1;
+		}
+
+		ticks = static_cast<int>(replay.GetTickCount());
+		deltaTime = 1.0f / replay.GetTickRate();
+		seed = replay.GetWorldSeed();
+		level = replay.GetLevel();
+		frameTime = 0;
+	}
+
+	GameMode gameMode;
+	gameMode.SetThreadCount(static_cast<unsigned int>(threadCount));
+	gameMode.SetTickRate(1.0f / deltaTime);
+	gameMode.SetWorldSeed(seed);
+
+	// the recording's level when replaying
+	Player* player = BuildLevel(gameMode, level);
+
+	if (replayPath)
+	{
+		gameMode.StartReplay(replay);
+		return RunReplay(gameMode, *player, replay, replayPath, csvPath);
+	}
+
+	Profiler& profiler = gameMode.GetProfiler();
+	if (csvPath && !profiler.OpenCsv(csvPath))
+	{
+		std::printf("can't write %s\n", csvPath);
+		return 1;
+	}
+	if (recordPath) gameMode.StartRecording(level);
+
+	auto start = std::chrono::steady_clock::now();
+
+	// with --frame-dt, --ticks counts frames and the simulated steps are whatever Advance ran
+	int steps = 0;
+	for (int i = 0; i < ticks; ++i)
+	{
+		gameMode.HandleInput();
+		if (frameTime > 0)
+		{
+			steps += gameMode.Advance(frameTime);
+		}
+		else
+		{
+			gameMode.Update(deltaTime);
+			++steps;
+		}
+		profiler.EndFrame();
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(end - start).count();
+
+	const bool legacyEnemies = level.enemyKind == kLevelActorEnemies;
+	const bool ecsEnemies = level.enemyKind == kLevelEntityEnemies;
+	std::printf("enemies: %u (%s)\n", level.enemyCount, legacyEnemies ? "actors" : ecsEnemies ? "entities" : "swarm");
+	if (ecsEnemies)
+	{
+		std::printf("entities: %zu alive in %zu archetypes, player health %.1f\n", gameMode.GetWorld().GetEntityCount(),
+			gameMode.GetWorld().GetArchetypeCount(), player->GetHealth());
+	}
+	if (frameTime > 0) std::printf("frames: %d (frame dt %.4f)\n", ticks, frameTime);
+	std::printf("ticks: %d (dt %.4f), threads: %u\n", steps, deltaTime, gameMode.GetThreadCount());
+	std::printf("time: %.3f ms\n", seconds * 1000.0);
+	std::printf("ticks/second: %.1f\n", seconds > 0.0 ? steps / seconds : 0.0);
+
+	const AIScheduler::Stats& ai = gameMode.GetAIScheduler().GetStats();
+	std::printf("ai: budget %.0f us, %zu thinks in %.1f us last tick, full pass every %llu ticks\n",
+		level.aiBudgetMicroseconds, ai.thinksLastRun, ai.microsecondsLastRun, static_cast<unsigned long long>(ai.lastPassTicks));
+
+	if (level.lodNear > 0 && !legacyEnemies && !ecsEnemies)
+	{
+		std::printf("lod: %zu of %zu swarm enemies moved last tick\n",
+			gameMode.GetEnemySwarm().GetTickedLastTick(), gameMode.GetEnemySwarm().Size());
+	}
+
+	if (recordPath && !gameMode.GetRecording().Save(recordPath))
+	{
+		std::printf("can't write recording %s\n", recordPath);
+		return 1;
+	}
+
+	std::printf("\n");
+	profiler.PrintSummary();
+
+	return 0;
+}
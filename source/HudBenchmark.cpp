@@ -0,0 +1,113 @@
+#include "Benchmarks.h"
+#include "HudText.h"
+#include "BatchRenderer.h"
+#include "TextureAtlas.h"
+#include "GameSprites.h"
+#include "Profiler.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+	const int kLabels = 40;
+	const int kFrames = 10000;
+
+	// stand-in for raylib's default font, which needs the window: 5x10 glyphs in RGBA8, a different
+	// pattern per character, same metrics shape (base size 10, advance from the rect)
+	struct BlockFont {
+		std::vector<Rectangle> recs;
+		std::vector<GlyphInfo> glyphs;
+		std::vector<std::vector<Color>> pixels;
+		Font font;
+
+		BlockFont()
+			: recs(HudFont::kCharCount)
+			, glyphs(HudFont::kCharCount)
+			, pixels(HudFont::kCharCount, std::vector<Color>(5 * 10, BLANK))
+		{
+			for (int i = 0; i < HudFont::kCharCount; ++i)
+			{
+				for (int p = 0; p < 5 * 10; ++p)
+				{
+					if ((p * 7 + i) % 3 == 0) pixels[i][p] = WHITE;
+				}
+				recs[i] = { static_cast<float>(i * 5), 0, 5, 10 };
+				glyphs[i] = { HudFont::kFirstChar + i, 0, 0, 0, Image{ pixels[i].data(), 5, 10, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 } };
+			}
+			font = { 10, HudFont::kCharCount, 0, Texture2D{ 0, 0, 0, 0, 0 }, recs.data(), glyphs.data() };
+		}
+	};
+
+	// label i changes every 1 + i % 60 frames, like counters that move at different rates (FPS about
+	// twice a second, scores now and then)
+	int ValueAt(int label, int frame)
+	{
+		return frame / (1 + label % 60) + label;
+	}
+
+	void AddLabels(HudText& hud)
+	{
+		for (int i = 0; i < kLabels; ++i)
+		{
+			hud.Add(i % 2 ? "counter: %i" : "range: %i / %i", 10.0f + (i % 4) * 200, 10.0f + (i / 4) * 20, 10 + (i % 3) * 5, DARKGRAY);
+		}
+	}
+
+} // namespace
+
+int RunHudBenchmark()
+{
+	BlockFont blockFont;
+	TextureAtlas atlas(256);
+	AddGameSprites(atlas);
+	HudFont font;
+	font.AddGlyphs(atlas, blockFont.font);
+	atlas.Build();
+
+	std::printf("HUD text: %d labels, %d frames, label i changes every 1 + i %% 60 frames, %d atlas page(s)\n", kLabels, kFrames, atlas.GetPageCount());
+
+	RenderCommandList commands;
+	char text[64];
+
+	// what main.cpp did: format every label every frame and hand the string to DrawText, which lays
+	// it out again. the null backend drops DrawText, so the layout is charged here through HudText
+	// with its cache defeated
+	HudText uncached(font);
+	AddLabels(uncached);
+	double start = Profiler::NowMs();
+	for (int frame = 0; frame < kFrames; ++frame)
+	{
+		commands.Clear();
+		for (int i = 0; i < kLabels; ++i)
+		{
+			std::snprintf(text, sizeof(text), i % 2 ? "counter: %i" : "range: %i / %i", ValueAt(i, frame), 100);
+			commands.PushText(text, 0, 0, 10, DARKGRAY);
+			uncached.Invalidate(i);
+			uncached.Set(i, ValueAt(i, frame), 100);
+		}
+	}
+	double uncachedMs = (Profiler::NowMs() - start) / kFrames;
+
+	BatchRenderer renderer;
+	renderer.SetAtlas(&atlas);
+	renderer.Submit(commands);
+	std::printf("  format + layout every frame: %7.4f ms/frame, %zu layouts, %zu DrawText calls per frame (a batch each in raylib)\n",
+		uncachedMs, uncached.GetLayoutCount(), commands.Size());
+
+	HudText hud(font);
+	AddLabels(hud);
+	start = Profiler::NowMs();
+	for (int frame = 0; frame < kFrames; ++frame)
+	{
+		commands.Clear();
+		for (int i = 0; i < kLabels; ++i) hud.Set(i, ValueAt(i, frame), 100);
+		hud.Draw(commands);
+	}
+	double cachedMs = (Profiler::NowMs() - start) / kFrames;
+
+	renderer.Submit(commands);
+	std::printf("  retained HudText:            %7.4f ms/frame, %zu layouts, %zu glyph quads in %zu rlgl batch(es) per frame\n",
+		cachedMs, hud.GetLayoutCount(), renderer.GetQuadCount(), renderer.GetBatchCount());
+	return 0;
+}
@@ -0,0 +1,149 @@
+#include "HudText.h"
+#include <cstdio>
+#include <cstring>
+
+void HudFont::AddGlyphs(TextureAtlas& atlas, const Font& font)
+{
+	baseSize = font.baseSize > 0 ? font.baseSize : 10;
+	for (int i = 0; i < kCharCount; ++i) glyphs[i] = { kNoSprite, 0, 0, 0, 0, 0 };
+
+	for (int i = 0; i < font.glyphCount; ++i)
+	{
+		const GlyphInfo& info = font.glyphs[i];
+		if (info.value < kFirstChar || info.value >= kFirstChar + kCharCount) continue;
+
+		const Rectangle& rec = font.recs[i];
+		Glyph& glyph = glyphs[info.value - kFirstChar];
+		glyph.offsetX = static_cast<float>(info.offsetX);
+		glyph.offsetY = static_cast<float>(info.offsetY);
+		glyph.width = rec.width;
+		glyph.height = rec.height;
+		glyph.advance = info.advanceX != 0 ? static_cast<float>(info.advanceX) : rec.width;
+
+		// whatever format the font keeps its glyphs in, the atlas wants RGBA8
+		if (info.value == ' ' || !info.image.data || info.image.width <= 0 || info.image.height <= 0) continue;
+		Color* colors = LoadImageColors(info.image);
+		if (!colors) continue;
+
+		SpriteImage image(info.image.width, info.image.height);
+		std::memcpy(image.pixels.data(), colors, image.pixels.size() * sizeof(Color));
+		UnloadImageColors(colors);
+
+		char name[16];
+		std::snprintf(name, sizeof(name), "glyph %d", info.value);
+		glyph.sprite = atlas.Add(name, std::move(image));
+	}
+
+	loaded = true;
+}
+
+const HudFont::Glyph& HudFont::GetGlyph(char character) const
+{
+	int index = static_cast<unsigned char>(character) - kFirstChar;
+	if (index < 0 || index >= kCharCount) index = '?' - kFirstChar;
+	return glyphs[index];
+}
+
+HudText::Label HudText::Add(const char* format, float x, float y, int fontSize, Color color)
+{
+	Entry entry;
+	entry.format = format;
+	entry.values[0] = entry.values[1] = entry.values[2] = 0;
+	entry.hasValues = false;
+	entry.visible = true;
+	entry.x = x;
+	entry.y = y;
+	entry.fontSize = fontSize;
+	entry.color = color;
+	if (!std::strstr(format, "%i"))
+	{
+		entry.text = format;
+		Layout(entry);
+	}
+
+	labels.push_back(std::move(entry));
+	return static_cast<Label>(labels.size() - 1);
+}
+
+void HudText::Set(Label label, int a, int b, int c)
+{
+	Entry& entry = labels[label];
+	if (entry.hasValues && entry.values[0] == a && entry.values[1] == b && entry.values[2] == c) return;
+
+	entry.values[0] = a;
+	entry.values[1] = b;
+	entry.values[2] = c;
+	entry.hasValues = true;
+
+	// unused values are ignored by snprintf
+	char text[256];
+	std::snprintf(text, sizeof(text), entry.format.c_str(), a, b, c);
+	entry.text = text;
+	Layout(entry);
+}
+
+void HudText::SetText(Label label, const char* text)
+{
+	Entry& entry = labels[label];
+	entry.hasValues = false;
+	if (entry.text == text) return;
+
+	entry.text = text;
+	Layout(entry);
+}
+
+void HudText::SetColor(Label label, Color color)
+{
+	Entry& entry = labels[label];
+	entry.color = color;
+	for (RenderCommand& glyph : entry.glyphs) glyph.color = color;
+}
+
+void HudText::Invalidate(Label label)
+{
+	Entry& entry = labels[label];
+	entry.hasValues = false;
+	entry.text.clear();
+	entry.glyphs.clear();
+}
+
+void HudText::Layout(Entry& entry)
+{
+	++layoutCount;
+	entry.glyphs.clear();
+
+	// same rules as raylib's DrawText with the default font: at least the base size, whole pixel spacing
+	const int baseSize = font.GetBaseSize();
+	const int fontSize = entry.fontSize < baseSize ? baseSize : entry.fontSize;
+	const float scale = static_cast<float>(fontSize) / baseSize;
+	const float spacing = static_cast<float>(fontSize / baseSize);
+
+	float offsetX = 0;
+	float offsetY = 0;
+	for (char character : entry.text)
+	{
+		if (character == '\n')
+		{
+			offsetY += static_cast<float>(static_cast<int>((baseSize + baseSize / 2) * scale));
+			offsetX = 0;
+			continue;
+		}
+
+		const HudFont::Glyph& glyph = font.GetGlyph(character);
+		if (glyph.sprite != kNoSprite && character != '\t')
+		{
+			entry.glyphs.push_back({ RenderCommand::Sprite, 0, 0, entry.color,
+				entry.x + offsetX + glyph.offsetX * scale, entry.y + offsetY + glyph.offsetY * scale,
+				glyph.width * scale, glyph.height * scale, glyph.sprite });
+		}
+		offsetX += glyph.advance * scale + spacing;
+	}
+}
+
+void HudText::Draw(RenderCommandList& commands) const
+{
+	for (const Entry& entry : labels)
+	{
+		if (entry.visible) commands.Append(entry.glyphs.data(), entry.glyphs.size());
+	}
+}
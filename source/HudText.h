@@ -0,0 +1,95 @@
+#pragma once
+#ifndef HUDTEXT_H
+#define HUDTEXT_H
+
+#include "RenderCommands.h"
+#include "TextureAtlas.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// the glyphs of a raylib font as atlas sprites, with the metrics DrawText lays them out by.
+// printable ASCII only, anything else draws as '?' like raylib's fallback
+class HudFont {
+public:
+	struct Glyph {
+		SpriteId sprite;   // kNoSprite for blank ones (space)
+		float offsetX;     // at the font's base size
+		float offsetY;
+		float width;
+		float height;
+		float advance;
+	};
+
+	// copies the glyph images into the atlas, before its Build. GetFontDefault() needs the window
+	void AddGlyphs(TextureAtlas& atlas, const Font& font);
+
+	bool IsLoaded() const { return loaded; }
+	int GetBaseSize() const { return baseSize; }
+	const Glyph& GetGlyph(char character) const;
+
+	static const int kFirstChar = 32;
+	static const int kCharCount = 95;
+
+private:
+	bool loaded = false;
+	int baseSize = 10;
+	Glyph glyphs[kCharCount] = {};
+};
+
+// retained HUD labels. a label is laid out into glyph sprite commands when its text changes and
+// those are copied into the frame as they are otherwise, so a label whose numbers didn't change
+// costs neither a format nor a layout. being atlas sprites, the glyphs go out in the same rlgl
+// batch as the world instead of a DrawText (and a flush) per string. not thread safe, the thread
+// that records the frame owns it
+class HudText {
+public:
+	typedef uint32_t Label;
+
+	explicit HudText(const HudFont& font) : font(font) {}
+
+	// format is printf style with up to three %i, or plain text. the label shows nothing until the
+	// first Set unless it has no %i
+	Label Add(const char* format, float x, float y, int fontSize, Color color);
+
+	// formats and relays out only when a value differs from the last Set
+	void Set(Label label, int a, int b = 0, int c = 0);
+	// replaces the text (the format is ignored from then on), relays out only when it differs
+	void SetText(Label label, const char* text);
+	void SetColor(Label label, Color color);
+	// drops the label's layout, the next Set or SetText lays it out whatever the values
+	void Invalidate(Label label);
+	void SetVisible(Label label, bool visible) { labels[label].visible = visible; }
+
+	// every visible label's glyphs, in Add order. goes after BeginScreenSpace
+	void Draw(RenderCommandList& commands) const;
+
+	const std::string& GetText(Label label) const { return labels[label].text; }
+	size_t GetLabelCount() const { return labels.size(); }
+	// layouts done so far, to see the cache working
+	size_t GetLayoutCount() const { return layoutCount; }
+
+private:
+	struct Entry {
+		std::string format;
+		std::string text;
+		int values[3];
+		bool hasValues;
+		bool visible;
+		float x;
+		float y;
+		int fontSize;
+		Color color;
+		std::vector<RenderCommand> glyphs;
+	};
+
+	// DrawText's layout: glyphs scaled to fontSize, fontSize / base size pixels between them
+	void Layout(Entry& entry);
+
+	const HudFont& font;
+	std::vector<Entry> labels;
+	size_t layoutCount = 0;
+};
+
+#endif // HUDTEXT_H
@@ -0,0 +1,148 @@
+#include "InputRecording.h"
+#include "raylib.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+	const char kMagic[4] = { 'R', 'I', 'N', 'P' };
+	const uint32_t kVersion = 3; // 2 added the think count, 3 the level. older ones aren't read
+
+	// fields are written as they are in memory, recordings are only moved between little endian boxes
+	template<typename T>
+	bool WriteValue(std::FILE* file, const T& value)
+	{
+		return std::fwrite(&value, sizeof(T), 1, file) == 1;
+	}
+
+	template<typename T>
+	bool ReadValue(std::FILE* file, T& value)
+	{
+		return std::fread(&value, sizeof(T), 1, file) == 1;
+	}
+
+	bool WriteVarint(std::FILE* file, uint32_t value)
+	{
+		do
+		{
+			uint8_t byte = value & 0x7F;
+			value >>= 7;
+			if (value) byte |= 0x80;
+			if (std::fputc(byte, file) == EOF) return false;
+		} while (value);
+		return true;
+	}
+
+	bool ReadVarint(std::FILE* file, uint32_t& value)
+	{
+		value = 0;
+		for (int shift = 0; shift < 35; shift += 7)
+		{
+			int byte = std::fgetc(file);
+			if (byte == EOF) return false;
+
+			value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) return true;
+		}
+		return false;
+	}
+
+} // namespace
+
+InputState InputState::Sample()
+{
+	InputState input;
+	if (IsKeyDown(KEY_RIGHT)) input.buttons |= kInputRight;
+	if (IsKeyDown(KEY_LEFT)) input.buttons |= kInputLeft;
+	if (IsKeyDown(KEY_DOWN)) input.buttons |= kInputDown;
+	if (IsKeyDown(KEY_UP)) input.buttons |= kInputUp;
+	return input;
+}
+
+InputRecording::InputRecording()
+	: worldSeed(0)
+	, tickRate(60.0f)
+	, thinksPerTick(0)
+{ }
+
+void InputRecording::Begin(uint64_t seed, float rate, const LevelDescription& recordedLevel, uint32_t thinks)
+{
+	worldSeed = seed;
+	tickRate = rate;
+	level = recordedLevel;
+	thinksPerTick = thinks;
+	ticks.clear();
+}
+
+bool InputRecording::Save(const char* path) const
+{
+	std::FILE* file = std::fopen(path, "wb");
+	if (!file) return false;
+
+	bool ok = std::fwrite(kMagic, sizeof(kMagic), 1, file) == 1
+		&& WriteValue(file, kVersion)
+		&& WriteValue(file, worldSeed)
+		&& WriteValue(file, tickRate)
+		&& WriteValue(file, level.enemyCount)
+		&& WriteValue(file, static_cast<uint8_t>(level.enemyKind))
+		&& WriteValue(file, static_cast<uint8_t>(level.walls))
+		&& WriteValue(file, level.lodNear)
+		&& WriteValue(file, level.lodFar)
+		&& WriteValue(file, level.aiBudgetMicroseconds)
+		&& WriteValue(file, thinksPerTick)
+		&& WriteValue(file, static_cast<uint32_t>(ticks.size()));
+
+	// runs of the same buttons, held keys and idle stretches collapse to a couple of bytes
+	for (size_t i = 0; ok && i < ticks.size();)
+	{
+		size_t run = 1;
+		while (i + run < ticks.size() && ticks[i + run].buttons == ticks[i].buttons) ++run;
+
+		ok = std::fputc(ticks[i].buttons, file) != EOF && WriteVarint(file, static_cast<uint32_t>(run));
+		i += run;
+	}
+
+	return std::fclose(file) == 0 && ok;
+}
+
+bool InputRecording::Load(const char* path)
+{
+	std::FILE* file = std::fopen(path, "rb");
+	if (!file) return false;
+
+	char magic[4];
+	uint32_t version = 0;
+	uint32_t tickCount = 0;
+	uint8_t enemyKind = 0;
+	uint8_t walls = 0;
+	bool ok = std::fread(magic, sizeof(magic), 1, file) == 1 && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0
+		&& ReadValue(file, version) && version == kVersion
+		&& ReadValue(file, worldSeed)
+		&& ReadValue(file, tickRate)
+		&& ReadValue(file, level.enemyCount)
+		&& ReadValue(file, enemyKind) && enemyKind <= kLevelEntityEnemies
+		&& ReadValue(file, walls)
+		&& ReadValue(file, level.lodNear)
+		&& ReadValue(file, level.lodFar)
+		&& ReadValue(file, level.aiBudgetMicroseconds)
+		&& ReadValue(file, thinksPerTick)
+		&& ReadValue(file, tickCount);
+
+	level.enemyKind = static_cast<LevelEnemyKind>(enemyKind);
+	level.walls = walls != 0;
+
+	ticks.clear();
+	if (ok) ticks.reserve(tickCount);
+
+	while (ok && ticks.size() < tickCount)
+	{
+		int buttons = std::fgetc(file);
+		uint32_t run = 0;
+		ok = buttons != EOF && ReadVarint(file, run) && run > 0 && run <= tickCount - ticks.size();
+		if (ok) ticks.insert(ticks.end(), run, InputState{ static_cast<uint8_t>(buttons) });
+	}
+
+	std::fclose(file);
+	if (!ok) ticks.clear();
+	return ok;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+
+#include "DefaultLevel.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// the buttons a tick can see, one bit each
+enum InputButton : uint8_t {
+	kInputRight = 1 << 0,
+	kInputLeft = 1 << 1,
+	kInputDown = 1 << 2,
+	kInputUp = 1 << 3,
+};
+
+// what gameplay reads instead of IsKeyDown. GameMode samples it once at the start of every tick
+// (or takes it from a replay), so the same inputs give the same game however the frames fall
+struct InputState {
+	uint8_t buttons = 0;
+
+	bool IsDown(InputButton button) const { return (buttons & button) != 0; }
+
+	// the keyboard right now (arrow keys)
+	static InputState Sample();
+};
+
+// per-tick inputs plus the world seed, tick rate, level and AI think count they were recorded with:
+// everything needed to play the same game again, windowed or headless. the file is a small header then
+// run-length encoded (buttons, varint run) pairs, a few bytes per second of play
+class InputRecording {
+public:
+	InputRecording();
+
+	// thinksPerTick: agents the AIScheduler thinks per tick, 0 = all of them. a fixed count rather
+	// than the time budget, which would let the machine's speed decide what enemies do
+	void Begin(uint64_t worldSeed, float tickRate, const LevelDescription& level, uint32_t thinksPerTick = 0);
+	void Push(InputState input) { ticks.push_back(input); }
+
+	uint64_t GetWorldSeed() const { return worldSeed; }
+	float GetTickRate() const { return tickRate; }
+	const LevelDescription& GetLevel() const { return level; }
+	uint32_t GetThinksPerTick() const { return thinksPerTick; }
+	size_t GetTickCount() const { return ticks.size(); }
+	// nothing pressed past the end
+	InputState GetTick(size_t tick) const { return tick < ticks.size() ? ticks[tick] : InputState(); }
+
+	// false if the file can't be written / read or isn't a recording. recordings from before the level
+	// and think count were stored are refused, there is no telling what they were made on
+	bool Save(const char* path) const;
+	bool Load(const char* path);
+
+private:
+	uint64_t worldSeed;
+	float tickRate;
+	LevelDescription level;
+	uint32_t thinksPerTick;
+	std::vector<InputState> ticks;
+};
+
+#endif // INPUTRECORDING_H
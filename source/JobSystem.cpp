@@ -0,0 +1,152 @@
+#include "JobSystem.h"
+
+namespace {
+	// set on worker threads (and on the caller while it is inside ParallelFor) so nested calls run inline
+	thread_local bool insideJobSystem = false;
+	thread_local size_t currentThreadIndex = 0;
+}
+
+JobSystem::JobSystem(unsigned int threadCount)
+	: queuedJobs(0)
+	, stopping(false)
+{
+	if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+	if (threadCount == 0) threadCount = 1;
+
+	for (unsigned int i = 0; i < threadCount; ++i)
+	{
+		queues.push_back(std::make_unique<WorkQueue>());
+	}
+
+	for (unsigned int i = 1; i < threadCount; ++i)
+	{
+		workers.emplace_back(&JobSystem::WorkerLoop, this, static_cast<size_t>(i));
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+	wakeWorkers.notify_all();
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+void JobSystem::ParallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& body)
+{
+	if (begin >= end) return;
+	if (grainSize == 0) grainSize = 1;
+
+	// single threaded pool, tiny range or nested call: nothing to gain from splitting
+	if (workers.empty() || end - begin <= grainSize || insideJobSystem)
+	{
+		body(begin, end);
+		return;
+	}
+
+	std::atomic<size_t> remaining(end - begin);
+
+	insideJobSystem = true;
+	Execute(0, { &body, begin, end, grainSize, &remaining });
+
+	// help out until every chunk of this range has finished
+	Job job;
+	while (remaining.load(std::memory_order_acquire) > 0)
+	{
+		if (TryGetJob(0, job)) Execute(0, job);
+		else std::this_thread::yield();
+	}
+	insideJobSystem = false;
+}
+
+void JobSystem::Execute(size_t queueIndex, Job job)
+{
+	// keep the lower half, offer the upper half to thieves
+	while (job.end - job.begin > job.grainSize)
+	{
+		size_t mid = job.begin + (job.end - job.begin) / 2;
+		Push(queueIndex, { job.body, mid, job.end, job.grainSize, job.remaining });
+		job.end = mid;
+	}
+
+	(*job.body)(job.begin, job.end);
+	job.remaining->fetch_sub(job.end - job.begin, std::memory_order_acq_rel);
+}
+
+void JobSystem::Push(size_t queueIndex, const Job& job)
+{
+	{
+		std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+		queues[queueIndex]->jobs.push_back(job);
+	}
+	queuedJobs.fetch_add(1, std::memory_order_release);
+
+	// a worker checks queuedJobs under sleepMutex before it sleeps, taking the lock here means it
+	// either saw the new job or is already waiting and gets the notify
+	{ std::lock_guard<std::mutex> lock(sleepMutex); }
+	wakeWorkers.notify_one();
+}
+
+bool JobSystem::TryGetJob(size_t queueIndex, Job& job)
+{
+	// own queue first, newest job (lifo keeps the cache warm)
+	{
+		WorkQueue& own = *queues[queueIndex];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.jobs.empty())
+		{
+			job = own.jobs.back();
+			own.jobs.pop_back();
+			queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	// then steal the oldest (biggest) job from someone else
+	const size_t count = queues.size();
+	for (size_t offset = 1; offset < count; ++offset)
+	{
+		WorkQueue& victim = *queues[(queueIndex + offset) % count];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty())
+		{
+			job = victim.jobs.front();
+			victim.jobs.pop_front();
+			queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+size_t JobSystem::GetCurrentThreadIndex()
+{
+	return currentThreadIndex;
+}
+
+void JobSystem::WorkerLoop(size_t queueIndex)
+{
+	insideJobSystem = true;
+	currentThreadIndex = queueIndex;
+
+	Job job;
+	while (true)
+	{
+		if (TryGetJob(queueIndex, job))
+		{
+			Execute(queueIndex, job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		wakeWorkers.wait(lock, [this] { return stopping.load() || queuedJobs.load() > 0; });
+		if (stopping) return;
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// fixed pool of worker threads with one work-stealing deque each.
+// a ParallelFor range is split in halves on demand: the thread running a range keeps the lower half
+// and pushes the upper half onto the back of its own deque, idle threads steal from the front of
+// other deques, so big chunks get stolen and small ones stay local.
+class JobSystem {
+public:
+	// threadCount includes the calling thread, 0 picks std::thread::hardware_concurrency()
+	explicit JobSystem(unsigned int threadCount = 0);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	unsigned int GetThreadCount() const { return static_cast<unsigned int>(workers.size()) + 1; }
+
+	// 1..GetThreadCount()-1 on this system's workers, 0 on any other thread (the game thread)
+	static size_t GetCurrentThreadIndex();
+
+	// runs body(chunkBegin, chunkEnd) over [begin, end) in chunks of at most grainSize and returns when all
+	// of them are done. the calling thread works too. meant to be called from one thread (the game thread),
+	// a ParallelFor issued from inside a job just runs inline.
+	void ParallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+private:
+	struct Job {
+		const std::function<void(size_t, size_t)>* body;
+		size_t begin;
+		size_t end;
+		size_t grainSize;
+		std::atomic<size_t>* remaining; // items left in the ParallelFor this job belongs to
+	};
+
+	struct WorkQueue {
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	void WorkerLoop(size_t queueIndex);
+	bool TryGetJob(size_t queueIndex, Job& job);
+	void Push(size_t queueIndex, const Job& job);
+	void Execute(size_t queueIndex, Job job);
+
+	// queue 0 belongs to the thread calling ParallelFor, 1..n to the workers
+	std::vector<std::unique_ptr<WorkQueue>> queues;
+	std::vector<std::thread> workers;
+
+	std::atomic<int> queuedJobs;
+	std::atomic<bool> stopping;
+	std::mutex sleepMutex;
+	std::condition_variable wakeWorkers;
+};
+
+#endif // JOBSYSTEM_H
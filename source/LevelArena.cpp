@@ -0,0 +1,66 @@
+#include "LevelArena.h"
+#include <cstdint>
+#include <new>
+
+LevelArena::LevelArena(size_t chunkSize)
+	: chunkSize(chunkSize)
+	, currentChunk(0)
+	, offset(0)
+	, usedInFullChunks(0)
+{ }
+
+LevelArena::~LevelArena()
+{
+	for (Chunk& chunk : chunks)
+	{
+		::operator delete(chunk.memory);
+	}
+}
+
+void* LevelArena::Allocate(size_t size, size_t alignment)
+{
+	// walk forward through the chunks we already own before asking the heap for another one
+	while (currentChunk < chunks.size())
+	{
+		Chunk& chunk = chunks[currentChunk];
+		uintptr_t base = reinterpret_cast<uintptr_t>(chunk.memory);
+		uintptr_t aligned = (base + offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+		size_t newOffset = static_cast<size_t>(aligned - base) + size;
+
+		if (newOffset <= chunk.size)
+		{
+			offset = newOffset;
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		usedInFullChunks += offset;
+		++currentChunk;
+		offset = 0;
+	}
+
+	size_t newChunkSize = size + alignment > chunkSize ? size + alignment : chunkSize;
+	chunks.push_back({ static_cast<unsigned char*>(::operator new(newChunkSize)), newChunkSize });
+	currentChunk = chunks.size() - 1;
+	offset = 0;
+
+	return Allocate(size, alignment);
+}
+
+void LevelArena::Reset()
+{
+	currentChunk = 0;
+	offset = 0;
+	usedInFullChunks = 0;
+}
+
+size_t LevelArena::GetBytesUsed() const
+{
+	return usedInFullChunks + offset;
+}
+
+size_t LevelArena::GetBytesReserved() const
+{
+	size_t total = 0;
+	for (const Chunk& chunk : chunks) total += chunk.size;
+	return total;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#ifndef LEVELARENA_H
+#define LEVELARENA_H
+
+#include <cstddef>
+#include <vector>
+
+// bump allocator for everything that lives exactly as long as a level.
+// memory comes from a few big chunks that are kept across levels, so once the first level has
+// warmed it up, spawning does no global heap allocation and freeing a level is a pointer reset.
+// the arena never runs destructors, whoever placement-news into it is responsible for that.
+class LevelArena {
+public:
+	explicit LevelArena(size_t chunkSize = 256 * 1024);
+	~LevelArena();
+
+	LevelArena(const LevelArena&) = delete;
+	LevelArena& operator=(const LevelArena&) = delete;
+
+	void* Allocate(size_t size, size_t alignment);
+
+	// drops everything allocated so far, keeps the chunks for reuse
+	void Reset();
+
+	size_t GetBytesUsed() const;
+	size_t GetBytesReserved() const;
+
+private:
+	struct Chunk {
+		unsigned char* memory;
+		size_t size;
+	};
+
+	std::vector<Chunk> chunks;
+	size_t chunkSize;
+	size_t currentChunk;
+	size_t offset;       // into chunks[currentChunk]
+	size_t usedInFullChunks;
+};
+
+#endif // LEVELARENA_H
@@ -0,0 +1,79 @@
+// null platform backend for the headless build
+// provides the handful of raylib functions the simulation touches so GameMode/Actor/Player/Enemy
+// link without raylib.lib, a window or a GPU. input reads as "nothing pressed", draws are dropped.
+
+#include "raylib.h"
+#include "rlgl.h"
+#include <cstdlib>
+
+int GetRandomValue(int min, int max)
+{
+	// same behaviour as raylib 4.2 so headless runs spawn like the game does
+	if (min > max)
+	{
+		int tmp = max;
+		max = min;
+		min = tmp;
+	}
+
+	return (rand() % (abs(max - min) + 1) + min);
+}
+
+bool IsKeyPressed(int key) { (void)key; return false; }
+bool IsKeyDown(int key) { (void)key; return false; }
+
+void DrawCircle(int centerX, int centerY, float radius, Color color)
+{
+	(void)centerX; (void)centerY; (void)radius; (void)color;
+}
+
+void DrawRectangle(int posX, int posY, int width, int height, Color color)
+{
+	(void)posX; (void)posY; (void)width; (void)height; (void)color;
+}
+
+// no GL, textures get id 0 and backends fall back to untextured quads
+Texture2D LoadTextureFromImage(Image image)
+{
+	(void)image;
+	return Texture2D{ 0, 0, 0, 0, 0 };
+}
+
+void UnloadTexture(Texture2D texture) { (void)texture; }
+
+void BeginMode2D(Camera2D camera) { (void)camera; }
+void EndMode2D(void) {}
+
+void DrawText(const char* text, int posX, int posY, int fontSize, Color color)
+{
+	(void)text; (void)posX; (void)posY; (void)fontSize; (void)color;
+}
+
+// rlgl, only what BatchRenderer::Submit uses
+void rlSetTexture(unsigned int id) { (void)id; }
+unsigned int rlGetTextureIdDefault(void) { return 1; }
+bool rlCheckRenderBatchLimit(int vCount) { (void)vCount; return false; }
+void rlBegin(int mode) { (void)mode; }
+void rlEnd(void) {}
+void rlNormal3f(float x, float y, float z) { (void)x; (void)y; (void)z; }
+void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a) { (void)r; (void)g; (void)b; (void)a; }
+void rlTexCoord2f(float x, float y) { (void)x; (void)y; }
+void rlVertex2f(float x, float y) { (void)x; (void)y; }
+
+// only the formats HudFont sees headless (RGBA8 and raylib's default font's gray + alpha)
+Color* LoadImageColors(Image image)
+{
+	if (!image.data) return nullptr;
+	size_t count = static_cast<size_t>(image.width) * image.height;
+	Color* colors = static_cast<Color*>(malloc(count * sizeof(Color)));
+	const unsigned char* data = static_cast<const unsigned char*>(image.data);
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) colors[i] = { data[i * 4], data[i * 4 + 1], data[i * 4 + 2], data[i * 4 + 3] };
+		else if (image.format == PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA) colors[i] = { data[i * 2], data[i * 2], data[i * 2], data[i * 2 + 1] };
+		else colors[i] = BLANK;
+	}
+	return colors;
+}
+
+void UnloadImageColors(Color* colors) { free(colors); }
@@ -0,0 +1,81 @@
+#include "Benchmarks.h"
+#include "GameMode.h"
+#include "Player.h"
+#include "DefaultLevel.h"
+#include "BatchRenderer.h"
+#include "RenderPipeline.h"
+
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+	const int kFrames = 300;
+	const float kFrameTime = 1.0f / 60.0f;
+
+	struct FrameTimes {
+		double frameMs;  // wall time per frame
+		double recordMs; // Advance + Draw, on whichever thread records
+		double submitMs; // BatchRenderer::Submit into the null rlgl, on the calling thread
+	};
+
+	// the main loop of main.cpp with the null backend as the consumer
+	FrameTimes RunFrames(size_t enemies, bool threaded)
+	{
+		GameMode gameMode;
+		gameMode.SetThreadCount(1); // the simulation keeps to one thread so the two sides don't fight over cores
+		gameMode.GetProfiler().SetEnabled(false);
+		gameMode.SetWorldSeed(22);
+
+		Player* player = BuildDefaultLevel(gameMode);
+		gameMode.GetEnemySwarm().SpawnWave(enemies, player);
+
+		BatchRenderer renderer;
+		RenderPipeline pipeline(threaded);
+		double recordMs = 0, submitMs = 0;
+
+		double start = Profiler::NowMs();
+		for (int frame = 0; frame < kFrames; ++frame)
+		{
+			gameMode.HandleInput();
+			pipeline.Kick([&gameMode, &recordMs](RenderCommandList& commands) {
+				double recordStart = Profiler::NowMs();
+				gameMode.Advance(kFrameTime);
+				gameMode.Draw(commands);
+				recordMs += Profiler::NowMs() - recordStart;
+			});
+
+			// same order as main.cpp: sequential submits the frame it just recorded
+			if (!threaded) pipeline.Wait();
+
+			double submitStart = Profiler::NowMs();
+			renderer.Submit(pipeline.GetFront());
+			submitMs += Profiler::NowMs() - submitStart;
+
+			if (threaded) pipeline.Wait();
+		}
+		double frameMs = (Profiler::NowMs() - start) / kFrames;
+
+		return { frameMs, recordMs / kFrames, submitMs / kFrames };
+	}
+
+} // namespace
+
+int RunPipelineBenchmark()
+{
+	std::printf("pipeline benchmark: default level + swarm, %d frames of Advance + Draw, submitted to the null rlgl backend, %u hardware threads\n",
+		kFrames, std::thread::hardware_concurrency());
+	std::printf("%8s %12s %12s %12s %12s %12s\n", "enemies", "record ms", "submit ms", "sequential", "pipelined", "speedup");
+
+	const size_t sizes[] = { 1000, 10000, 50000 };
+	for (size_t enemies : sizes)
+	{
+		FrameTimes sequential = RunFrames(enemies, false);
+		FrameTimes pipelined = RunFrames(enemies, true);
+
+		std::printf("%8zu %12.3f %12.3f %12.3f %12.3f %11.2fx\n", enemies, sequential.recordMs, sequential.submitMs,
+			sequential.frameMs, pipelined.frameMs, sequential.frameMs / pipelined.frameMs);
+	}
+
+	return 0;
+}
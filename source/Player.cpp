@@ -1,4 +1,7 @@
 #include "Player.h"
+#include "RenderCommands.h"
+#include "GameSprites.h"
+#include "GameMode.h"
 
 Player::Player()
 	:speed(200.0f),
@@ -15,26 +18,41 @@ void Player::BeginPlay()
 void Player::Tick(float deltaTime)
 {
 	//handles player movement
-	if (IsKeyDown(KEY_RIGHT)) position.x += speed * deltaTime;
-	if (IsKeyDown(KEY_LEFT)) position.x -= speed * deltaTime;
-	if (IsKeyDown(KEY_DOWN)) position.y += speed * deltaTime;
-	if (IsKeyDown(KEY_UP)) position.y -= speed * deltaTime;
+	InputState input = GetGameMode() ? GetGameMode()->GetInput() : InputState();
+	if (input.IsDown(kInputRight)) position.x += speed * deltaTime;
+	if (input.IsDown(kInputLeft)) position.x -= speed * deltaTime;
+	if (input.IsDown(kInputDown)) position.y += speed * deltaTime;
+	if (input.IsDown(kInputUp)) position.y -= speed * deltaTime;
 
-	// keep player on screen
-	if (position.x < 0) position.x = 0;
-	if (position.x > 800) position.x = 800;
-	if (position.y < 0) position.y = 0;
-	if (position.y > 600) position.y = 600;
+	// keep player inside the level and out of walls
+	if (GameMode* gameMode = GetGameMode())
+	{
+		Rectangle bounds = gameMode->GetCameraBounds();
+		if (position.x < bounds.x) position.x = bounds.x;
+		if (position.x > bounds.x + bounds.width) position.x = bounds.x + bounds.width;
+		if (position.y < bounds.y) position.y = bounds.y;
+		if (position.y > bounds.y + bounds.height) position.y = bounds.y + bounds.height;
+
+		position = gameMode->GetFlowField().Slide(GetPreviousPosition(), position);
+	}
 
 
 }
 
-void Player::Draw()
+void Player::TakeDamage(float amount)
 {
-	// draws player as triangle by default
-	DrawCircle(position.x, position.y, 20, BLUE);
+	health -= amount;
+	if (health < 0) health = 0;
+}
+
+void Player::Draw(RenderCommandList& commands)
+{
+	Vector2 drawPos = GetRenderPosition();
+
+	// draws player as a blue ball
+	commands.PushSprite(kSpritePlayer, drawPos.x - 20, drawPos.y - 20, 40, 40);
 
 	//Drad health bar
-	DrawRectangle(position.x - 25, position.y - 30, 50, 5, LIGHTGRAY);
-	DrawRectangle(position.x - 25, position.y - 30, 50 * (health / 100.0f), 5, GREEN);
+	commands.PushRect(drawPos.x - 25, drawPos.y - 30, 50, 5, LIGHTGRAY);
+	commands.PushRect(drawPos.x - 25, drawPos.y - 30, 50 * (health / 100.0f), 5, GREEN);
 }
\ No newline at end of file
@@ -9,7 +9,12 @@ public:
 	Player();
 	virtual void BeginPlay() override;
 	virtual void Tick(float deltaTime) override;
-	virtual void Draw() override;
+	virtual void Draw(RenderCommandList& commands) override;
+
+	virtual float GetCollisionRadius() const override { return 20.0f; }
+	virtual bool TakesContactDamage() const override { return true; }
+	virtual void TakeDamage(float amount) override;
+	virtual float GetHealth() const override { return health; }
 
 private:
 	float speed;
@@ -0,0 +1,185 @@
+#include "PngFile.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+	const unsigned char kSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	const size_t kMaxStoredBlock = 65535;
+
+	struct CrcTable {
+		uint32_t entries[256];
+
+		CrcTable()
+		{
+			for (uint32_t n = 0; n < 256; ++n)
+			{
+				uint32_t c = n;
+				for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+				entries[n] = c;
+			}
+		}
+	};
+
+	uint32_t Crc32(const unsigned char* data, size_t size)
+	{
+		static const CrcTable table;
+
+		uint32_t crc = 0xFFFFFFFFu;
+		for (size_t i = 0; i < size; ++i) crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		return ~crc;
+	}
+
+	uint32_t Adler32(const unsigned char* data, size_t size)
+	{
+		uint32_t a = 1, b = 0;
+		for (size_t i = 0; i < size; ++i)
+		{
+			a = (a + data[i]) % 65521;
+			b = (b + a) % 65521;
+		}
+		return (b << 16) | a;
+	}
+
+	void PutU32(std::vector<unsigned char>& out, uint32_t value)
+	{
+		out.push_back(static_cast<unsigned char>(value >> 24));
+		out.push_back(static_cast<unsigned char>(value >> 16));
+		out.push_back(static_cast<unsigned char>(value >> 8));
+		out.push_back(static_cast<unsigned char>(value));
+	}
+
+	uint32_t GetU32(const unsigned char* data)
+	{
+		return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | data[3];
+	}
+
+	void PutChunk(std::vector<unsigned char>& out, const char type[4], const std::vector<unsigned char>& data)
+	{
+		PutU32(out, static_cast<uint32_t>(data.size()));
+		size_t crcStart = out.size();
+		out.insert(out.end(), type, type + 4);
+		out.insert(out.end(), data.begin(), data.end());
+		PutU32(out, Crc32(&out[crcStart], out.size() - crcStart));
+	}
+
+} // namespace
+
+bool WritePng(const char* path, const Color* pixels, int width, int height)
+{
+	// scanlines: filter byte 0 (none) then the row
+	const size_t rowBytes = static_cast<size_t>(width) * 4;
+	std::vector<unsigned char> raw;
+	raw.reserve((rowBytes + 1) * height);
+	for (int y = 0; y < height; ++y)
+	{
+		raw.push_back(0);
+		const unsigned char* row = reinterpret_cast<const unsigned char*>(pixels + static_cast<size_t>(y) * width);
+		raw.insert(raw.end(), row, row + rowBytes);
+	}
+
+	// zlib stream of stored blocks
+	std::vector<unsigned char> zlib = { 0x78, 0x01 };
+	for (size_t at = 0; at < raw.size() || at == 0; at += kMaxStoredBlock)
+	{
+		size_t size = raw.size() - at < kMaxStoredBlock ? raw.size() - at : kMaxStoredBlock;
+		bool last = at + size == raw.size();
+		zlib.push_back(last ? 1 : 0);
+		zlib.push_back(static_cast<unsigned char>(size));
+		zlib.push_back(static_cast<unsigned char>(size >> 8));
+		zlib.push_back(static_cast<unsigned char>(~size));
+		zlib.push_back(static_cast<unsigned char>(~size >> 8));
+		zlib.insert(zlib.end(), raw.begin() + at, raw.begin() + at + size);
+		if (last) break;
+	}
+	PutU32(zlib, Adler32(raw.data(), raw.size()));
+
+	std::vector<unsigned char> header;
+	PutU32(header, static_cast<uint32_t>(width));
+	PutU32(header, static_cast<uint32_t>(height));
+	header.push_back(8); // bit depth
+	header.push_back(6); // RGBA
+	header.push_back(0); // deflate
+	header.push_back(0); // adaptive filters
+	header.push_back(0); // no interlace
+
+	std::vector<unsigned char> file(kSignature, kSignature + 8);
+	PutChunk(file, "IHDR", header);
+	PutChunk(file, "IDAT", zlib);
+	PutChunk(file, "IEND", {});
+
+	std::FILE* out = std::fopen(path, "wb");
+	if (!out) return false;
+	bool ok = std::fwrite(file.data(), 1, file.size(), out) == file.size();
+	return std::fclose(out) == 0 && ok;
+}
+
+bool ReadPng(const char* path, std::vector<Color>& pixels, int& width, int& height)
+{
+	std::FILE* in = std::fopen(path, "rb");
+	if (!in) return false;
+
+	std::vector<unsigned char> file;
+	unsigned char buffer[65536];
+	size_t got;
+	while ((got = std::fread(buffer, 1, sizeof(buffer), in)) > 0) file.insert(file.end(), buffer, buffer + got);
+	std::fclose(in);
+
+	if (file.size() < 8 || std::memcmp(file.data(), kSignature, 8) != 0) return false;
+
+	std::vector<unsigned char> zlib;
+	width = height = 0;
+	for (size_t at = 8; at + 12 <= file.size();)
+	{
+		uint32_t size = GetU32(&file[at]);
+		if (at + 12 + size > file.size()) return false;
+		const unsigned char* type = &file[at + 4];
+		const unsigned char* data = &file[at + 8];
+		if (GetU32(data + size) != Crc32(type, size + 4)) return false;
+
+		if (std::memcmp(type, "IHDR", 4) == 0)
+		{
+			if (size != 13 || data[8] != 8 || data[9] != 6 || data[12] != 0) return false;
+			width = static_cast<int>(GetU32(data));
+			height = static_cast<int>(GetU32(data + 4));
+		}
+		else if (std::memcmp(type, "IDAT", 4) == 0)
+		{
+			zlib.insert(zlib.end(), data, data + size);
+		}
+		else if (std::memcmp(type, "IEND", 4) == 0)
+		{
+			break;
+		}
+		at += 12 + size;
+	}
+
+	if (width <= 0 || height <= 0 || zlib.size() < 6) return false;
+
+	// stored blocks only
+	std::vector<unsigned char> raw;
+	size_t at = 2;
+	for (bool last = false; !last;)
+	{
+		if (at + 5 > zlib.size() || (zlib[at] & 0x06) != 0) return false;
+		last = (zlib[at] & 1) != 0;
+		size_t size = zlib[at + 1] | (zlib[at + 2] << 8);
+		at += 5;
+		if (at + size > zlib.size()) return false;
+		raw.insert(raw.end(), zlib.begin() + at, zlib.begin() + at + size);
+		at += size;
+	}
+
+	const size_t rowBytes = static_cast<size_t>(width) * 4;
+	if (raw.size() != (rowBytes + 1) * height) return false;
+
+	pixels.resize(static_cast<size_t>(width) * height);
+	for (int y = 0; y < height; ++y)
+	{
+		const unsigned char* row = &raw[y * (rowBytes + 1)];
+		if (row[0] != 0) return false;
+		std::memcpy(&pixels[static_cast<size_t>(y) * width], row + 1, rowBytes);
+	}
+	return true;
+}
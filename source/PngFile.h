@@ -0,0 +1,14 @@
+#pragma once
+#ifndef PNGFILE_H
+#define PNGFILE_H
+
+#include "raylib.h"
+#include <vector>
+
+// 8 bit RGBA PNGs without a zlib dependency: the image data goes in stored (uncompressed) deflate
+// blocks, so files are about as big as the raw pixels but any viewer opens them. ReadPng reads
+// those back, i.e. what WritePng writes (stored deflate, no filters, RGBA8), not PNGs in general
+bool WritePng(const char* path, const Color* pixels, int width, int height);
+bool ReadPng(const char* path, std::vector<Color>& pixels, int& width, int& height);
+
+#endif // PNGFILE_H
@@ -0,0 +1,151 @@
+#include "Profiler.h"
+#include "RenderCommands.h"
+#include <algorithm>
+
+Profiler::Profiler()
+	: frameCount(0)
+	, enabled(true)
+	, overlayVisible(false)
+	, csv(nullptr)
+	, csvColumns(0)
+	, csvHeaderWritten(false)
+{ }
+
+Profiler::~Profiler()
+{
+	CloseCsv();
+}
+
+size_t Profiler::AddPhase(const std::string& name)
+{
+	for (size_t i = 0; i < phases.size(); ++i)
+	{
+		if (phases[i].name == name) return i;
+	}
+
+	Phase phase;
+	phase.name = name;
+	phase.current = 0;
+	phase.history.assign(kHistoryFrames, 0.0f);
+	phases.push_back(std::move(phase));
+	return phases.size() - 1;
+}
+
+void Profiler::EndFrame()
+{
+	if (!enabled) return;
+
+	size_t slot = frameCount % kHistoryFrames;
+	for (Phase& phase : phases)
+	{
+		phase.history[slot] = static_cast<float>(phase.current);
+	}
+
+	if (csv)
+	{
+		if (!csvHeaderWritten)
+		{
+			csvColumns = phases.size();
+			std::fprintf(csv, "frame");
+			for (size_t i = 0; i < csvColumns; ++i) std::fprintf(csv, ",%s", phases[i].name.c_str());
+			std::fprintf(csv, "\n");
+			csvHeaderWritten = true;
+		}
+
+		std::fprintf(csv, "%zu", frameCount);
+		for (size_t i = 0; i < csvColumns; ++i) std::fprintf(csv, ",%.4f", phases[i].current);
+		std::fprintf(csv, "\n");
+	}
+
+	for (Phase& phase : phases)
+	{
+		phase.current = 0;
+	}
+	++frameCount;
+}
+
+Profiler::PhaseStats Profiler::GetStats(size_t phase) const
+{
+	PhaseStats stats = { 0, 0, 0, 0 };
+	size_t count = std::min(frameCount, kHistoryFrames);
+	if (count == 0) return stats;
+
+	const std::vector<float>& history = phases[phase].history;
+
+	// the window is small, a sorted copy is cheaper than keeping a running quantile around
+	float sorted[kHistoryFrames];
+	double sum = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		sorted[i] = history[i];
+		sum += history[i];
+	}
+	std::sort(sorted, sorted + count);
+
+	stats.minMs = sorted[0];
+	stats.avgMs = sum / count;
+	stats.p99Ms = sorted[std::min(count - 1, (count * 99) / 100)];
+	stats.lastMs = history[(frameCount - 1) % kHistoryFrames];
+	return stats;
+}
+
+void Profiler::DrawOverlay(RenderCommandList& commands, int x, int y) const
+{
+	if (!overlayVisible) return;
+
+	const int lineHeight = 14;
+	const int columns[] = { 0, 150, 210, 270, 330 };
+
+	commands.PushRect(x - 5, y - 5, 395, static_cast<float>((phases.size() + 1) * lineHeight + 10), Color{ 0, 0, 0, 150 });
+
+	const char* headers[] = { "phase (ms)", "last", "min", "avg", "p99" };
+	for (int c = 0; c < 5; ++c)
+	{
+		commands.PushText(headers[c], x + columns[c], y, 10, LIGHTGRAY);
+	}
+
+	char text[32];
+	for (size_t i = 0; i < phases.size(); ++i)
+	{
+		int lineY = y + static_cast<int>(i + 1) * lineHeight;
+		PhaseStats stats = GetStats(i);
+		const double values[] = { stats.lastMs, stats.minMs, stats.avgMs, stats.p99Ms };
+
+		commands.PushText(phases[i].name.c_str(), x, lineY, 10, RAYWHITE);
+		for (int c = 0; c < 4; ++c)
+		{
+			std::snprintf(text, sizeof(text), "%.3f", values[c]);
+			commands.PushText(text, x + columns[c + 1], lineY, 10, RAYWHITE);
+		}
+	}
+}
+
+bool Profiler::OpenCsv(const char* path)
+{
+	CloseCsv();
+
+	csv = std::fopen(path, "w");
+	csvHeaderWritten = false;
+	return csv != nullptr;
+}
+
+void Profiler::CloseCsv()
+{
+	if (csv)
+	{
+		std::fclose(csv);
+		csv = nullptr;
+	}
+}
+
+void Profiler::PrintSummary() const
+{
+	std::printf("%-24s %10s %10s %10s  (ms per frame, last %zu frames)\n", "phase", "min", "avg", "p99",
+		std::min(frameCount, kHistoryFrames));
+
+	for (size_t i = 0; i < phases.size(); ++i)
+	{
+		PhaseStats stats = GetStats(i);
+		std::printf("%-24s %10.4f %10.4f %10.4f\n", phases[i].name.c_str(), stats.minMs, stats.avgMs, stats.p99Ms);
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class RenderCommandList;
+
+// per-phase frame timings. phases add up their time during a frame (Update runs several times per
+// frame on a catch-up, so its samples are summed), EndFrame pushes each total into a rolling
+// window that min/avg/p99 are computed from. only the game thread records.
+class Profiler {
+public:
+	static constexpr size_t kHistoryFrames = 240;
+
+	struct PhaseStats {
+		double minMs;
+		double avgMs;
+		double p99Ms;
+		double lastMs;
+	};
+
+	Profiler();
+	~Profiler();
+
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+
+	// returns the existing id when the name is already known
+	size_t AddPhase(const std::string& name);
+	size_t GetPhaseCount() const { return phases.size(); }
+	const std::string& GetPhaseName(size_t phase) const { return phases[phase].name; }
+
+	void Record(size_t phase, double milliseconds) { if (enabled) phases[phase].current += milliseconds; }
+	void EndFrame();
+
+	PhaseStats GetStats(size_t phase) const;
+	size_t GetFrameCount() const { return frameCount; }
+
+	// timers are skipped entirely while disabled
+	void SetEnabled(bool isEnabled) { enabled = isEnabled; }
+	bool IsEnabled() const { return enabled; }
+
+	void SetOverlayVisible(bool visible) { overlayVisible = visible; }
+	bool IsOverlayVisible() const { return overlayVisible; }
+	// into the list's screen space, reads what EndFrame last stored
+	void DrawOverlay(RenderCommandList& commands, int x, int y) const;
+
+	// one row per frame from here on: frame, then one column per phase known at the time of the header
+	// (the first EndFrame after opening, phases added later are left out). false if the file can't be opened
+	bool OpenCsv(const char* path);
+	void CloseCsv();
+
+	// min/avg/p99 table on stdout, for headless runs
+	void PrintSummary() const;
+
+	static double NowMs()
+	{
+		using namespace std::chrono;
+		return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+	}
+
+private:
+	struct Phase {
+		std::string name;
+		double current;                 // this frame so far
+		std::vector<float> history;     // ring of kHistoryFrames totals
+	};
+
+	std::vector<Phase> phases;
+	size_t frameCount;
+	bool enabled;
+	bool overlayVisible;
+
+	std::FILE* csv;
+	size_t csvColumns;
+	bool csvHeaderWritten;
+};
+
+// times its scope into a phase
+class ScopedTimer {
+public:
+	ScopedTimer(Profiler& owner, size_t phaseId)
+		: profiler(owner), phase(phaseId), start(owner.IsEnabled() ? Profiler::NowMs() : 0) {}
+	~ScopedTimer() { if (profiler.IsEnabled()) profiler.Record(phase, Profiler::NowMs() - start); }
+
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+	Profiler& profiler;
+	size_t phase;
+	double start;
+};
+
+#endif // PROFILER_H
@@ -0,0 +1,107 @@
+#pragma once
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+
+// game random numbers. everything derives from the game mode's world seed: Rng(seed, stream) gives an
+// independent xoshiro128** sequence per stream, so an actor's numbers depend only on the seed and
+// its stream, not on which thread ran it or what else drew numbers first. 16 bytes of state, no locks.
+// GetRandomValue is raylib's global rand(): not thread safe, not reproducible per actor, a modulo per call
+
+// stream ids, one range per owner so they never overlap
+static constexpr uint64_t kRngStreamSwarm = 1;
+static constexpr uint64_t kRngStreamScenario = 2;        // spawn scripts outside the game mode (headless, benches)
+static constexpr uint64_t kRngStreamFirstThread = 1ull << 32; // + job system thread index
+static constexpr uint64_t kRngStreamFirstActor = 1ull << 48;  // + spawn order
+
+// mixes a 64 bit state into a well spread 64 bit value, used to seed the generators
+inline uint64_t SplitMix64(uint64_t& state)
+{
+	uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+class Rng {
+public:
+	Rng() { Seed(0, 0); }
+	Rng(uint64_t seed, uint64_t stream) { Seed(seed, stream); }
+
+	void Seed(uint64_t seed, uint64_t stream)
+	{
+		uint64_t mix = seed;
+		uint64_t streamMix = stream;
+		mix ^= SplitMix64(streamMix);
+
+		uint64_t a = SplitMix64(mix);
+		uint64_t b = SplitMix64(mix);
+		state[0] = static_cast<uint32_t>(a);
+		state[1] = static_cast<uint32_t>(a >> 32);
+		state[2] = static_cast<uint32_t>(b);
+		state[3] = static_cast<uint32_t>(b >> 32);
+		if ((state[0] | state[1] | state[2] | state[3]) == 0) state[0] = 1; // all zero never leaves zero
+	}
+
+	uint32_t NextU32()
+	{
+		const uint32_t result = Rotl(state[1] * 5, 7) * 9;
+		const uint32_t t = state[1] << 9;
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = Rotl(state[3], 11);
+
+		return result;
+	}
+
+	// [0, 1), the top 24 bits so every value is exact
+	float NextFloat() { return (NextU32() >> 8) * (1.0f / 16777216.0f); }
+
+	// [min, max)
+	float Range(float min, float max) { return min + (max - min) * NextFloat(); }
+
+	// [min, max] like GetRandomValue, by multiply and shift instead of a modulo
+	int RangeInt(int min, int max)
+	{
+		if (min > max)
+		{
+			int tmp = max;
+			max = min;
+			min = tmp;
+		}
+
+		const uint32_t span = static_cast<uint32_t>(static_cast<int64_t>(max) - min + 1);
+		if (span == 0) return static_cast<int>(NextU32()); // the whole int range
+		return static_cast<int>(static_cast<int64_t>(min) + static_cast<int64_t>((static_cast<uint64_t>(NextU32()) * span) >> 32));
+	}
+
+	// batch versions, same numbers as calling Range / RangeInt count times
+	void FillRange(float* out, size_t count, float min, float max)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] = Range(min, max);
+		}
+	}
+
+	void FillRangeInt(int* out, size_t count, int min, int max)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] = RangeInt(min, max);
+		}
+	}
+
+private:
+	static uint32_t Rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+	uint32_t state[4];
+};
+
+#endif // RANDOM_H
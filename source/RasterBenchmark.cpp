@@ -0,0 +1,115 @@
+#include "Benchmarks.h"
+#include "SoftwareRenderer.h"
+#include "RenderCommands.h"
+#include "TextureAtlas.h"
+#include "GameSprites.h"
+#include "Random.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+	const int kWidth = 1920;
+	const int kHeight = 1080;
+	const int kFrames = 20;
+
+	// a busy 1080p frame: sprites of every game kind, circles, translucent rects over all of it,
+	// and a screen space bar on top. same commands every run
+	void RecordScene(RenderCommandList& commands, int count)
+	{
+		Rng rng(24, kRngStreamScenario);
+		commands.Clear();
+
+		Camera2D camera = {};
+		camera.offset = { kWidth * 0.5f, kHeight * 0.5f };
+		camera.target = { kWidth * 0.5f, kHeight * 0.5f };
+		camera.zoom = 1.0f;
+		commands.SetCamera(camera);
+
+		const SpriteId sprites[] = { kSpritePlayer, kSpriteEnemy, kSpriteActor, kSpriteWhiteDisc };
+		for (int i = 0; i < count; ++i)
+		{
+			float x = rng.Range(-20.0f, kWidth);
+			float y = rng.Range(-20.0f, kHeight);
+			float size = rng.Range(10.0f, 48.0f);
+			unsigned char alpha = static_cast<unsigned char>(rng.RangeInt(64, 256));
+			Color color = { static_cast<unsigned char>(rng.RangeInt(0, 256)), static_cast<unsigned char>(rng.RangeInt(0, 256)), 200, alpha };
+
+			switch (i % 4)
+			{
+			case 0: commands.PushSprite(sprites[(i / 4) % 4], x, y, size, size); break;
+			case 1: commands.PushCircle(x, y, size * 0.5f, color); break;
+			case 2: commands.PushRect(x, y, size * 2, size, color); break;
+			default: commands.PushSprite(sprites[(i / 4) % 4], x, y, size, size, color); break;
+			}
+		}
+
+		commands.BeginScreenSpace();
+		commands.PushRect(0, 0, kWidth, 40, Color{ 0, 0, 0, 160 });
+	}
+
+	// FNV-1a over the image, to see every thread count drew the same one
+	uint64_t HashPixels(const SoftwareRenderer& renderer)
+	{
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(renderer.GetPixels());
+		size_t size = static_cast<size_t>(renderer.GetWidth()) * renderer.GetHeight() * sizeof(Color);
+		uint64_t hash = 0xCBF29CE484222325ull;
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 0x100000001B3ull;
+		}
+		return hash;
+	}
+
+} // namespace
+
+int RunRasterBenchmark()
+{
+	unsigned int maxThreads = std::thread::hardware_concurrency();
+	if (maxThreads == 0) maxThreads = 1;
+
+	std::vector<unsigned int> counts;
+	for (unsigned int n = 1; n < maxThreads; n *= 2) counts.push_back(n);
+	counts.push_back(maxThreads);
+
+	TextureAtlas atlas(256);
+	AddGameSprites(atlas);
+	atlas.Build();
+
+	std::printf("software rasterizer: %dx%d, %dx%d tiles, %d frames each\n", kWidth, kHeight,
+		SoftwareRenderer::kTileSize, SoftwareRenderer::kTileSize, kFrames);
+
+	RenderCommandList commands;
+	const int primitiveCounts[] = { 10000, 50000 };
+	for (int count : primitiveCounts)
+	{
+		RecordScene(commands, count);
+		std::printf("%6d sprites/circles/rects\n", count);
+
+		double baseline = 0;
+		uint64_t firstHash = 0;
+		for (unsigned int threads : counts)
+		{
+			SoftwareRenderer renderer(kWidth, kHeight, threads);
+			renderer.SetAtlas(&atlas);
+			renderer.Submit(commands); // warm up, lets the workers spin up
+
+			auto start = std::chrono::steady_clock::now();
+			for (int frame = 0; frame < kFrames; ++frame) renderer.Submit(commands);
+			double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kFrames;
+			if (threads == 1) baseline = ms;
+
+			uint64_t hash = HashPixels(renderer);
+			if (threads == counts.front()) firstHash = hash;
+
+			std::printf("  %3u threads  %8.3f ms/frame  %5.2fx  image %016llx%s\n", threads, ms, baseline / ms,
+				static_cast<unsigned long long>(hash), hash == firstHash ? "" : "  DIFFERS");
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#ifndef RENDERBACKEND_H
+#define RENDERBACKEND_H
+
+#include "RenderCommands.h"
+#include "TextureAtlas.h"
+
+// what turns a recorded frame into pixels. BatchRenderer draws through rlgl (the window),
+// SoftwareRenderer into an image on the CPU (headless tests and benchmarks). both read sprites from
+// the same atlas, which the caller keeps alive
+class RenderBackend {
+public:
+	virtual ~RenderBackend() {}
+
+	void SetAtlas(const TextureAtlas* newAtlas) { atlas = newAtlas; }
+	const TextureAtlas* GetAtlas() const { return atlas; }
+
+	// world commands through the list's camera, then the screen space ones
+	virtual void Submit(const RenderCommandList& commands) = 0;
+
+protected:
+	const TextureAtlas* atlas = nullptr;
+};
+
+#endif // RENDERBACKEND_H
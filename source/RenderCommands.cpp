@@ -0,0 +1,16 @@
+#include "RenderCommands.h"
+#include <cstring>
+
+void RenderCommandList::Clear()
+{
+	commands.clear();
+	text.clear();
+	screenSpaceStart = SIZE_MAX;
+}
+
+void RenderCommandList::PushText(const char* string, float x, float y, int fontSize, Color color)
+{
+	uint32_t offset = static_cast<uint32_t>(text.size());
+	text.insert(text.end(), string, string + std::strlen(string) + 1);
+	commands.push_back({ RenderCommand::Text, 0, static_cast<uint16_t>(fontSize), color, x, y, 0, 0, offset });
+}
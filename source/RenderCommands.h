@@ -0,0 +1,81 @@
+#pragma once
+#ifndef RENDERCOMMANDS_H
+#define RENDERCOMMANDS_H
+
+#include "raylib.h"
+#include "TextureAtlas.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// one shape of the frame, 28 bytes of plain data. a circle is one command here, it only turns into
+// a fan of quads when a backend draws it
+struct RenderCommand {
+	enum Type : uint8_t { Rect, Circle, Text, Sprite };
+
+	uint8_t type;
+	uint8_t segments;    // Circle
+	uint16_t fontSize;   // Text
+	Color color;         // Sprite: tint
+	float x;             // Rect, Sprite, Text: top left, Circle: center
+	float y;
+	float width;         // Rect, Sprite: width, Circle: radius
+	float height;        // Rect, Sprite
+	uint32_t payload;    // Text: offset into the list's text (null terminated), Sprite: atlas region
+};
+
+// what Draw records instead of talking to rlgl: the frame's shapes in draw order plus the camera
+// they are seen through, all plain data so a finished list can be handed to another thread and
+// drawn there (see RenderPipeline) while the next frame records. commands before
+// BeginScreenSpace() are in world units, the ones after in screen pixels (HUD)
+class RenderCommandList {
+public:
+	// start a new frame, keeps the capacity, the camera and nothing else
+	void Clear();
+	void Reserve(size_t count) { commands.reserve(commands.size() + count); }
+
+	void PushRect(float x, float y, float width, float height, Color color)
+	{
+		commands.push_back({ RenderCommand::Rect, 0, 0, color, x, y, width, height, 0 });
+	}
+
+	void PushCircle(float centerX, float centerY, float radius, Color color, int segments = 36)
+	{
+		commands.push_back({ RenderCommand::Circle, static_cast<uint8_t>(segments), 0, color, centerX, centerY, radius, 0, 0 });
+	}
+
+	// an atlas region stretched over the rect, see TextureAtlas
+	void PushSprite(SpriteId sprite, float x, float y, float width, float height, Color tint = WHITE)
+	{
+		commands.push_back({ RenderCommand::Sprite, 0, 0, tint, x, y, width, height, sprite });
+	}
+
+	// commands recorded earlier, e.g. the glyphs HudText keeps laid out
+	void Append(const RenderCommand* first, size_t count)
+	{
+		commands.insert(commands.end(), first, first + count);
+	}
+
+	// the text is copied
+	void PushText(const char* string, float x, float y, int fontSize, Color color);
+
+	void SetCamera(const Camera2D& newCamera) { camera = newCamera; }
+	const Camera2D& GetCamera() const { return camera; }
+
+	// everything pushed from here on is drawn without the camera. once per frame
+	void BeginScreenSpace() { screenSpaceStart = commands.size(); }
+	size_t GetScreenSpaceStart() const { return screenSpaceStart < commands.size() ? screenSpaceStart : commands.size(); }
+
+	size_t Size() const { return commands.size(); }
+	const RenderCommand& operator[](size_t index) const { return commands[index]; }
+	const RenderCommand* GetCommands() const { return commands.data(); }
+	const char* GetText(const RenderCommand& command) const { return &text[command.payload]; }
+
+private:
+	std::vector<RenderCommand> commands;
+	std::vector<char> text;
+	Camera2D camera = { { 0, 0 }, { 0, 0 }, 0, 1.0f };
+	size_t screenSpaceStart = SIZE_MAX; // all world space until BeginScreenSpace
+};
+
+#endif // RENDERCOMMANDS_H
@@ -0,0 +1,77 @@
+#include "RenderPipeline.h"
+#include "Profiler.h"
+#include <utility>
+
+RenderPipeline::RenderPipeline(bool threaded)
+	: front(0)
+	, threaded(threaded)
+	, lastWaitMs(0)
+	, hasJob(false)
+	, quit(false)
+{
+	if (threaded) recorder = std::thread(&RenderPipeline::RecordLoop, this);
+}
+
+RenderPipeline::~RenderPipeline()
+{
+	if (!threaded) return;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	wake.notify_one();
+	recorder.join();
+}
+
+void RenderPipeline::Kick(std::function<void(RenderCommandList&)> record)
+{
+	RenderCommandList& back = lists[1 - front];
+	back.Clear();
+
+	if (!threaded)
+	{
+		record(back);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		job = std::move(record);
+		hasJob = true;
+	}
+	wake.notify_one();
+}
+
+void RenderPipeline::Wait()
+{
+	double start = Profiler::NowMs();
+	if (threaded)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [this] { return !hasJob; });
+	}
+	lastWaitMs = Profiler::NowMs() - start;
+
+	front = 1 - front;
+}
+
+void RenderPipeline::RecordLoop()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;)
+	{
+		wake.wait(lock, [this] { return hasJob || quit; });
+		if (quit) return;
+
+		// the caller only flips front in Wait, once this job is done
+		RenderCommandList& back = lists[1 - front];
+		std::function<void(RenderCommandList&)> record = std::move(job);
+		lock.unlock();
+		record(back);
+		lock.lock();
+
+		hasJob = false;
+		finished.notify_one();
+	}
+}
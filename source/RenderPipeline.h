@@ -0,0 +1,56 @@
+#pragma once
+#ifndef RENDERPIPELINE_H
+#define RENDERPIPELINE_H
+
+#include "RenderCommands.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// double-buffered frames between a recording thread and the thread that draws them. Kick starts the
+// next frame (simulation + Draw into the back list) on the pipeline's own thread, the caller draws
+// the front list meanwhile, Wait swaps them. a frame then costs the longer of the two instead of
+// their sum, at one frame of extra latency. the GL context can't leave the main thread, so the main
+// thread is the render consumer and the simulation is what moves. one frame in flight at a time:
+// between Wait and the next Kick nothing is recording, that's the window for raylib input and
+// anything else the simulation thread must not race with
+class RenderPipeline {
+public:
+	// threaded = false runs the recording inline in Kick, the sequential baseline
+	explicit RenderPipeline(bool threaded = true);
+	~RenderPipeline();
+
+	RenderPipeline(const RenderPipeline&) = delete;
+	RenderPipeline& operator=(const RenderPipeline&) = delete;
+
+	// record(list) fills the back list, which comes cleared apart from its camera
+	void Kick(std::function<void(RenderCommandList&)> record);
+	// waits for the kicked frame to be recorded, then it becomes the front
+	void Wait();
+
+	// what the last Wait finished, empty before the first one
+	const RenderCommandList& GetFront() const { return lists[front]; }
+	bool IsThreaded() const { return threaded; }
+
+	// how long the caller spent blocked in the last Wait, i.e. how much longer recording took than drawing
+	double GetLastWaitMs() const { return lastWaitMs; }
+
+private:
+	void RecordLoop();
+
+	RenderCommandList lists[2];
+	int front;
+	bool threaded;
+	double lastWaitMs;
+
+	std::function<void(RenderCommandList&)> job;
+	bool hasJob;
+	bool quit;
+	std::mutex mutex;
+	std::condition_variable wake;     // recording thread: a job or quit
+	std::condition_variable finished; // caller: the job is done
+	std::thread recorder;
+};
+
+#endif // RENDERPIPELINE_H
@@ -0,0 +1,151 @@
+#include "Benchmarks.h"
+#include "GameMode.h"
+#include "Enemy.h"
+#include "Player.h"
+#include "SeekKernel.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+	const float kDeltaTime = 1.0f / 60.0f;
+	const Vector2 kPlayerStart = { 400, 300 };
+
+	// about 20M enemy updates per measurement, at least 3 ticks
+	int TicksFor(size_t count)
+	{
+		size_t ticks = 20000000 / count;
+		return static_cast<int>(ticks < 3 ? 3 : ticks);
+	}
+
+	struct SoAEnemies {
+		std::vector<float> x, y, targetX, targetY, speed, health;
+
+		SoAEnemies(const std::vector<Vector2>& start, Vector2 target)
+		{
+			for (const Vector2& p : start)
+			{
+				x.push_back(p.x);
+				y.push_back(p.y);
+				targetX.push_back(target.x);
+				targetY.push_back(target.y);
+				speed.push_back(50.0f);
+				health.push_back(50.0f);
+			}
+		}
+
+		SeekBatch Batch()
+		{
+			return { x.data(), y.data(), targetX.data(), targetY.data(), speed.data(), health.data(), x.size() };
+		}
+	};
+
+	// Enemy actors at the given positions, all chasing one player, ticked on one thread
+	struct LegacyScene {
+		GameMode gameMode;
+		Player* player;
+		std::vector<Enemy*> enemies;
+
+		explicit LegacyScene(const std::vector<Vector2>& start)
+		{
+			gameMode.SetThreadCount(1);
+			gameMode.ReserveActors(start.size() + 1);
+			player = gameMode.SpawnActor<Player>(kPlayerStart);
+
+			enemies.reserve(start.size());
+			for (const Vector2& p : start)
+			{
+				Enemy* enemy = gameMode.SpawnActor<Enemy>({ 0, 0 });
+				enemy->SetPosition(p);
+				enemy->SetTarget(player);
+				enemies.push_back(enemy);
+			}
+		}
+	};
+
+	// false when a path is out of tolerance
+	bool RunSize(size_t count)
+	{
+		// same start positions for every size and every run
+		std::vector<Vector2> start(count);
+		Rng rng(1, kRngStreamScenario);
+		for (Vector2& p : start)
+		{
+			p.x = static_cast<float>(rng.RangeInt(50, 750));
+			p.y = static_cast<float>(rng.RangeInt(50, 550));
+		}
+
+		const int ticks = TicksFor(count);
+
+		// Enemy actors' own Tick, called directly: the seek plus the grid separation and flow field slide
+		// Enemy::Tick does on top, so it is listed for reference and not compared against the kernels.
+		// one Update first fills the grid and the flow field the ticks read
+		{
+			LegacyScene scene(start);
+			scene.gameMode.Update(kDeltaTime);
+
+			double begin = Profiler::NowMs();
+			for (int t = 0; t < ticks; ++t)
+			{
+				for (Enemy* enemy : scene.enemies) enemy->Tick(kDeltaTime);
+			}
+			double ns = (Profiler::NowMs() - begin) * 1e6 / (static_cast<double>(ticks) * count);
+			std::printf("%9zu  %-14s %8.3f ns/enemy  (seek + separation + slide, not compared)\n", count, "Enemy::Tick", ns);
+		}
+
+		// accuracy: one isolated seek step from the same start, the scalar kernel being the reference
+		// (Enemy::Tick also separates and slides, so it can't be). compared against the tolerance in
+		// SeekKernel.h. comparing after many ticks is meaningless once enemies reach the target and jitter around it
+		SoAEnemies reference(start, kPlayerStart);
+		SeekKernel(reference.Batch(), kDeltaTime, SeekPath::Scalar);
+
+		// speedups are against the scalar kernel, the same seek step without SIMD
+		double scalarNs = 0;
+		bool allInTolerance = true;
+		const SeekPath paths[] = { SeekPath::Scalar, SeekPath::SSE, SeekPath::AVX2, SeekPath::AVX512 };
+		for (SeekPath path : paths)
+		{
+			if (!IsSeekPathSupported(path)) continue;
+
+			SoAEnemies enemies(start, kPlayerStart);
+			SeekBatch batch = enemies.Batch();
+
+			SeekKernel(batch, kDeltaTime, path);
+			float maxError = 0;
+			for (size_t i = 0; i < count; ++i)
+			{
+				maxError = std::fmax(maxError, std::fabs(reference.x[i] - enemies.x[i]));
+				maxError = std::fmax(maxError, std::fabs(reference.y[i] - enemies.y[i]));
+			}
+
+			double begin = Profiler::NowMs();
+			for (int t = 0; t < ticks; ++t) SeekKernel(batch, kDeltaTime, path);
+			double ns = (Profiler::NowMs() - begin) * 1e6 / (static_cast<double>(ticks) * count);
+			if (path == SeekPath::Scalar) scalarNs = ns;
+			const bool inTolerance = maxError <= 1e-4f;
+			allInTolerance = allInTolerance && inTolerance;
+
+			std::printf("%9zu  %-14s %8.3f ns/enemy  %6.2fx  max step error %.2e%s\n",
+				count, GetSeekPathName(path), ns, scalarNs / ns, maxError, inTolerance ? "" : " (OUT OF TOLERANCE)");
+		}
+		return allInTolerance;
+	}
+
+} // namespace
+
+int RunSeekBenchmark()
+{
+	std::printf("seek kernel benchmark, best path: %s\n", GetSeekPathName(GetBestSeekPath()));
+
+	bool allInTolerance = true;
+	const size_t sizes[] = { 1000, 10000, 100000, 1000000 };
+	for (size_t count : sizes)
+	{
+		allInTolerance = RunSize(count) && allInTolerance;
+	}
+
+	if (!allInTolerance) std::printf("a seek path is out of tolerance\n");
+	return allInTolerance ? 0 : 2;
+}
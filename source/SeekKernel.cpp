@@ -0,0 +1,237 @@
+#include "SeekKernel.h"
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SEEK_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define SEEK_X86 0
+#endif
+
+// msvc lets any function use any intrinsic, gcc/clang need the isa enabled per function
+#if SEEK_X86 && (defined(__GNUC__) || defined(__clang__))
+#define SEEK_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SEEK_TARGET(isa)
+#endif
+
+namespace {
+
+	// scalar path, same math as Enemy::Tick (also used for the tails of the vector paths)
+	void SeekScalar(const SeekBatch& b, size_t begin, float deltaTime)
+	{
+		for (size_t i = begin; i < b.count; ++i)
+		{
+			if (b.health[i] <= 0) continue;
+
+			float dx = b.targetX[i] - b.posX[i];
+			float dy = b.targetY[i] - b.posY[i];
+			float distance = std::sqrt(dx * dx + dy * dy);
+
+			if (distance > 0)
+			{
+				b.posX[i] += (dx / distance) * b.speed[i] * deltaTime;
+				b.posY[i] += (dy / distance) * b.speed[i] * deltaTime;
+			}
+		}
+	}
+
+#if SEEK_X86
+	SEEK_TARGET("sse2")
+	void SeekSSE(const SeekBatch& b, float deltaTime)
+	{
+		const __m128 dt = _mm_set1_ps(deltaTime);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 threeHalves = _mm_set1_ps(1.5f);
+
+		size_t i = 0;
+		for (; i + 4 <= b.count; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(b.posX + i);
+			__m128 y = _mm_loadu_ps(b.posY + i);
+			__m128 dx = _mm_sub_ps(_mm_loadu_ps(b.targetX + i), x);
+			__m128 dy = _mm_sub_ps(_mm_loadu_ps(b.targetY + i), y);
+			__m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+			// ~12 bit estimate, one newton-raphson step takes it to ~22 bits
+			__m128 inv = _mm_rsqrt_ps(d2);
+			inv = _mm_mul_ps(inv, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, d2), _mm_mul_ps(inv, inv))));
+
+			__m128 moving = _mm_and_ps(_mm_cmpgt_ps(d2, zero), _mm_cmpgt_ps(_mm_loadu_ps(b.health + i), zero));
+			__m128 step = _mm_and_ps(_mm_mul_ps(_mm_mul_ps(inv, _mm_loadu_ps(b.speed + i)), dt), moving);
+
+			_mm_storeu_ps(b.posX + i, _mm_add_ps(x, _mm_mul_ps(dx, step)));
+			_mm_storeu_ps(b.posY + i, _mm_add_ps(y, _mm_mul_ps(dy, step)));
+		}
+
+		SeekScalar(b, i, deltaTime);
+	}
+
+	SEEK_TARGET("avx2")
+	void SeekAVX2(const SeekBatch& b, float deltaTime)
+	{
+		const __m256 dt = _mm256_set1_ps(deltaTime);
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 half = _mm256_set1_ps(0.5f);
+		const __m256 threeHalves = _mm256_set1_ps(1.5f);
+
+		size_t i = 0;
+		for (; i + 8 <= b.count; i += 8)
+		{
+			__m256 x = _mm256_loadu_ps(b.posX + i);
+			__m256 y = _mm256_loadu_ps(b.posY + i);
+			__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(b.targetX + i), x);
+			__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(b.targetY + i), y);
+			__m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+
+			__m256 inv = _mm256_rsqrt_ps(d2);
+			inv = _mm256_mul_ps(inv, _mm256_sub_ps(threeHalves, _mm256_mul_ps(_mm256_mul_ps(half, d2), _mm256_mul_ps(inv, inv))));
+
+			__m256 moving = _mm256_and_ps(_mm256_cmp_ps(d2, zero, _CMP_GT_OQ), _mm256_cmp_ps(_mm256_loadu_ps(b.health + i), zero, _CMP_GT_OQ));
+			__m256 step = _mm256_and_ps(_mm256_mul_ps(_mm256_mul_ps(inv, _mm256_loadu_ps(b.speed + i)), dt), moving);
+
+			_mm256_storeu_ps(b.posX + i, _mm256_add_ps(x, _mm256_mul_ps(dx, step)));
+			_mm256_storeu_ps(b.posY + i, _mm256_add_ps(y, _mm256_mul_ps(dy, step)));
+		}
+
+		SeekScalar(b, i, deltaTime);
+	}
+
+	SEEK_TARGET("avx512f")
+	void SeekAVX512(const SeekBatch& b, float deltaTime)
+	{
+		const __m512 dt = _mm512_set1_ps(deltaTime);
+		const __m512 zero = _mm512_setzero_ps();
+		const __m512 half = _mm512_set1_ps(0.5f);
+		const __m512 threeHalves = _mm512_set1_ps(1.5f);
+
+		size_t i = 0;
+		for (; i + 16 <= b.count; i += 16)
+		{
+			__m512 x = _mm512_loadu_ps(b.posX + i);
+			__m512 y = _mm512_loadu_ps(b.posY + i);
+			__m512 dx = _mm512_sub_ps(_mm512_loadu_ps(b.targetX + i), x);
+			__m512 dy = _mm512_sub_ps(_mm512_loadu_ps(b.targetY + i), y);
+			__m512 d2 = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+
+			__mmask16 moving = _mm512_cmp_ps_mask(d2, zero, _CMP_GT_OQ) & _mm512_cmp_ps_mask(_mm512_loadu_ps(b.health + i), zero, _CMP_GT_OQ);
+
+			// 14 bit estimate here (zeroed for lanes that don't move), newton-raphson still brings it to ~23 bits
+			__m512 inv = _mm512_maskz_rsqrt14_ps(moving, d2);
+			inv = _mm512_mul_ps(inv, _mm512_sub_ps(threeHalves, _mm512_mul_ps(_mm512_mul_ps(half, d2), _mm512_mul_ps(inv, inv))));
+			__m512 step = _mm512_mul_ps(_mm512_mul_ps(inv, _mm512_loadu_ps(b.speed + i)), dt);
+
+			_mm512_storeu_ps(b.posX + i, _mm512_add_ps(x, _mm512_mul_ps(dx, step)));
+			_mm512_storeu_ps(b.posY + i, _mm512_add_ps(y, _mm512_mul_ps(dy, step)));
+		}
+
+		SeekScalar(b, i, deltaTime);
+	}
+
+	struct CpuFeatures {
+		bool sse2 = false;
+		bool avx2 = false;
+		bool avx512 = false;
+	};
+
+	CpuFeatures DetectCpuFeatures()
+	{
+		CpuFeatures features;
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		features.sse2 = (info[3] & (1 << 26)) != 0;
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+
+		// the os has to save ymm/zmm state too, not just the cpu supporting it
+		unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+		bool ymmEnabled = (xcr0 & 0x6) == 0x6;
+		bool zmmEnabled = (xcr0 & 0xe6) == 0xe6;
+
+		if (maxLeaf >= 7)
+		{
+			__cpuidex(info, 7, 0);
+			features.avx2 = avx && ymmEnabled && (info[1] & (1 << 5)) != 0;
+			features.avx512 = zmmEnabled && (info[1] & (1 << 16)) != 0;
+		}
+#else
+		__builtin_cpu_init();
+		features.sse2 = __builtin_cpu_supports("sse2");
+		features.avx2 = __builtin_cpu_supports("avx2");
+		features.avx512 = __builtin_cpu_supports("avx512f");
+#endif
+		return features;
+	}
+
+	const CpuFeatures& GetCpuFeatures()
+	{
+		static const CpuFeatures features = DetectCpuFeatures();
+		return features;
+	}
+#endif // SEEK_X86
+
+} // namespace
+
+bool IsSeekPathSupported(SeekPath path)
+{
+	switch (path)
+	{
+	case SeekPath::Scalar: return true;
+#if SEEK_X86
+	case SeekPath::SSE: return GetCpuFeatures().sse2;
+	case SeekPath::AVX2: return GetCpuFeatures().avx2;
+	case SeekPath::AVX512: return GetCpuFeatures().avx512;
+#endif
+	default: return false;
+	}
+}
+
+SeekPath GetBestSeekPath()
+{
+	static const SeekPath best =
+		IsSeekPathSupported(SeekPath::AVX512) ? SeekPath::AVX512 :
+		IsSeekPathSupported(SeekPath::AVX2) ? SeekPath::AVX2 :
+		IsSeekPathSupported(SeekPath::SSE) ? SeekPath::SSE :
+		SeekPath::Scalar;
+	return best;
+}
+
+const char* GetSeekPathName(SeekPath path)
+{
+	switch (path)
+	{
+	case SeekPath::Scalar: return "scalar";
+	case SeekPath::SSE: return "sse";
+	case SeekPath::AVX2: return "avx2";
+	case SeekPath::AVX512: return "avx512";
+	}
+	return "unknown";
+}
+
+void SeekKernel(const SeekBatch& batch, float deltaTime)
+{
+	SeekKernel(batch, deltaTime, GetBestSeekPath());
+}
+
+void SeekKernel(const SeekBatch& batch, float deltaTime, SeekPath path)
+{
+	if (!IsSeekPathSupported(path)) path = SeekPath::Scalar;
+
+	switch (path)
+	{
+#if SEEK_X86
+	case SeekPath::SSE: SeekSSE(batch, deltaTime); return;
+	case SeekPath::AVX2: SeekAVX2(batch, deltaTime); return;
+	case SeekPath::AVX512: SeekAVX512(batch, deltaTime); return;
+#endif
+	default: SeekScalar(batch, 0, deltaTime); return;
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef SEEKKERNEL_H
+#define SEEKKERNEL_H
+
+#include <cstddef>
+
+// batched version of Enemy::Tick's "move towards target" step over structure-of-arrays data.
+// vector paths use reciprocal square root (+ one newton-raphson step) instead of sqrt and two
+// divides. tolerance against the scalar path: the direction is good to ~1e-6 relative, so after one
+// step positions agree to within one float ulp of the position plus ~1e-6 of the step length,
+// i.e. <= 1e-4 world units per step anywhere in an 800x600 (up to ~1000 units) world.
+
+struct SeekBatch {
+	float* posX;
+	float* posY;
+	const float* targetX;  // per enemy target position, set it to the enemy's own position for "no target"
+	const float* targetY;
+	const float* speed;
+	const float* health;   // enemies with health <= 0 do not move
+	size_t count;
+};
+
+enum class SeekPath {
+	Scalar,
+	SSE,     // 4 enemies per instruction
+	AVX2,    // 8
+	AVX512   // 16
+};
+
+// widest path this cpu (and os) supports, checked once
+SeekPath GetBestSeekPath();
+bool IsSeekPathSupported(SeekPath path);
+const char* GetSeekPathName(SeekPath path);
+
+// runs the best supported path
+void SeekKernel(const SeekBatch& batch, float deltaTime);
+// runs a specific path (falls back to scalar if unsupported)
+void SeekKernel(const SeekBatch& batch, float deltaTime, SeekPath path);
+
+#endif // SEEKKERNEL_H
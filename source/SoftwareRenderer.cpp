@@ -0,0 +1,215 @@
+#include "SoftwareRenderer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+	// src over dst, dst stays opaque
+	inline void Blend(Color& dst, Color src)
+	{
+		if (src.a == 255)
+		{
+			dst = src;
+			return;
+		}
+		if (src.a == 0) return;
+
+		const int a = src.a;
+		const int inverse = 255 - a;
+		dst.r = static_cast<unsigned char>((src.r * a + dst.r * inverse + 127) / 255);
+		dst.g = static_cast<unsigned char>((src.g * a + dst.g * inverse + 127) / 255);
+		dst.b = static_cast<unsigned char>((src.b * a + dst.b * inverse + 127) / 255);
+	}
+
+	inline Color Modulate(Color texel, Color tint)
+	{
+		return Color{
+			static_cast<unsigned char>((texel.r * tint.r + 127) / 255),
+			static_cast<unsigned char>((texel.g * tint.g + 127) / 255),
+			static_cast<unsigned char>((texel.b * tint.b + 127) / 255),
+			static_cast<unsigned char>((texel.a * tint.a + 127) / 255),
+		};
+	}
+
+	// first pixel whose center is at or right of edge
+	inline int FirstPixel(float edge)
+	{
+		return static_cast<int>(std::ceil(edge - 0.5f));
+	}
+
+} // namespace
+
+SoftwareRenderer::SoftwareRenderer(int width, int height, unsigned int threadCount)
+	: width(width)
+	, height(height)
+	, tilesX((width + kTileSize - 1) / kTileSize)
+	, tilesY((height + kTileSize - 1) / kTileSize)
+	, clearColor(RAYWHITE)
+	, pixels(static_cast<size_t>(width) * height)
+	, tileBins(static_cast<size_t>(tilesX) * tilesY)
+	, skippedText(0)
+	, jobs(threadCount)
+{ }
+
+void SoftwareRenderer::AddPrimitive(const RenderCommand& command, const Camera2D* camera)
+{
+	Primitive primitive = {};
+	primitive.type = command.type;
+	primitive.color = command.color;
+
+	float x0, y0, x1, y1;
+	if (command.type == RenderCommand::Circle)
+	{
+		x0 = command.x - command.width;
+		y0 = command.y - command.width;
+		x1 = command.x + command.width;
+		y1 = command.y + command.width;
+	}
+	else
+	{
+		x0 = std::min(command.x, command.x + command.width);
+		y0 = std::min(command.y, command.y + command.height);
+		x1 = std::max(command.x, command.x + command.width);
+		y1 = std::max(command.y, command.y + command.height);
+	}
+
+	// Camera2D without rotation: screen = (world - target) * zoom + offset
+	if (camera)
+	{
+		x0 = (x0 - camera->target.x) * camera->zoom + camera->offset.x;
+		y0 = (y0 - camera->target.y) * camera->zoom + camera->offset.y;
+		x1 = (x1 - camera->target.x) * camera->zoom + camera->offset.x;
+		y1 = (y1 - camera->target.y) * camera->zoom + camera->offset.y;
+	}
+
+	primitive.x0 = x0;
+	primitive.y0 = y0;
+	primitive.x1 = x1;
+	primitive.y1 = y1;
+	primitive.radius = (x1 - x0) * 0.5f;
+
+	if (command.type == RenderCommand::Sprite && atlas && atlas->IsBuilt())
+	{
+		const TextureAtlas::Region& region = atlas->GetRegion(command.payload);
+		primitive.page = &atlas->GetPage(region.page);
+		primitive.source = region.source;
+	}
+
+	// nothing of it on screen, or no pixel center inside
+	int left = std::max(FirstPixel(x0), 0);
+	int top = std::max(FirstPixel(y0), 0);
+	int right = std::min(FirstPixel(x1), width);
+	int bottom = std::min(FirstPixel(y1), height);
+	if (left >= right || top >= bottom) return;
+
+	const uint32_t index = static_cast<uint32_t>(primitives.size());
+	primitives.push_back(primitive);
+
+	for (int tileY = top / kTileSize; tileY <= (bottom - 1) / kTileSize; ++tileY)
+	{
+		for (int tileX = left / kTileSize; tileX <= (right - 1) / kTileSize; ++tileX)
+		{
+			tileBins[static_cast<size_t>(tileY) * tilesX + tileX].push_back(index);
+		}
+	}
+}
+
+void SoftwareRenderer::Submit(const RenderCommandList& commands)
+{
+	primitives.clear();
+	skippedText = 0;
+	for (std::vector<uint32_t>& bin : tileBins) bin.clear();
+
+	const size_t screenSpaceStart = commands.GetScreenSpaceStart();
+	for (size_t i = 0; i < commands.Size(); ++i)
+	{
+		if (commands[i].type == RenderCommand::Text)
+		{
+			++skippedText;
+			continue;
+		}
+		AddPrimitive(commands[i], i < screenSpaceStart ? &commands.GetCamera() : nullptr);
+	}
+
+	jobs.ParallelFor(0, tileBins.size(), 1, [this](size_t begin, size_t end) {
+		for (size_t tile = begin; tile < end; ++tile) RasterTile(tile);
+	});
+}
+
+void SoftwareRenderer::RasterTile(size_t tile)
+{
+	const int tileLeft = static_cast<int>(tile % tilesX) * kTileSize;
+	const int tileTop = static_cast<int>(tile / tilesX) * kTileSize;
+	const int tileRight = std::min(tileLeft + kTileSize, width);
+	const int tileBottom = std::min(tileTop + kTileSize, height);
+
+	for (int y = tileTop; y < tileBottom; ++y)
+	{
+		std::fill(&pixels[static_cast<size_t>(y) * width + tileLeft], &pixels[static_cast<size_t>(y) * width + tileRight], clearColor);
+	}
+
+	for (uint32_t index : tileBins[tile])
+	{
+		const Primitive& primitive = primitives[index];
+		const int left = std::max(FirstPixel(primitive.x0), tileLeft);
+		const int top = std::max(FirstPixel(primitive.y0), tileTop);
+		const int right = std::min(FirstPixel(primitive.x1), tileRight);
+		const int bottom = std::min(FirstPixel(primitive.y1), tileBottom);
+
+		switch (primitive.type)
+		{
+		case RenderCommand::Circle:
+		{
+			const float centerX = (primitive.x0 + primitive.x1) * 0.5f;
+			const float centerY = (primitive.y0 + primitive.y1) * 0.5f;
+			const float radiusSquared = primitive.radius * primitive.radius;
+			for (int y = top; y < bottom; ++y)
+			{
+				// the row's span inside the circle, same pixel center rule as the bounds
+				float dy = y + 0.5f - centerY;
+				float spanSquared = radiusSquared - dy * dy;
+				if (spanSquared <= 0) continue;
+				float half = std::sqrt(spanSquared);
+				int spanLeft = std::max(FirstPixel(centerX - half), left);
+				int spanRight = std::min(FirstPixel(centerX + half), right);
+
+				Color* row = &pixels[static_cast<size_t>(y) * width];
+				for (int x = spanLeft; x < spanRight; ++x) Blend(row[x], primitive.color);
+			}
+			break;
+		}
+		case RenderCommand::Sprite:
+			if (primitive.page)
+			{
+				const SpriteImage& page = *primitive.page;
+				const float scaleX = primitive.source.width / (primitive.x1 - primitive.x0);
+				const float scaleY = primitive.source.height / (primitive.y1 - primitive.y0);
+				const int lastX = static_cast<int>(primitive.source.width) - 1;
+				const int lastY = static_cast<int>(primitive.source.height) - 1;
+
+				for (int y = top; y < bottom; ++y)
+				{
+					int texelY = std::min(static_cast<int>((y + 0.5f - primitive.y0) * scaleY), lastY);
+					const Color* texels = &page.At(static_cast<int>(primitive.source.x), static_cast<int>(primitive.source.y) + texelY);
+					Color* row = &pixels[static_cast<size_t>(y) * width];
+					for (int x = left; x < right; ++x)
+					{
+						int texelX = std::min(static_cast<int>((x + 0.5f - primitive.x0) * scaleX), lastX);
+						Blend(row[x], Modulate(texels[texelX], primitive.color));
+					}
+				}
+				break;
+			}
+			// no atlas: a solid rect of the tint, like BatchRenderer
+			// fall through
+		default:
+			for (int y = top; y < bottom; ++y)
+			{
+				Color* row = &pixels[static_cast<size_t>(y) * width];
+				if (primitive.color.a == 255) std::fill(row + left, row + right, primitive.color);
+				else for (int x = left; x < right; ++x) Blend(row[x], primitive.color);
+			}
+			break;
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+#ifndef SOFTWARERENDERER_H
+#define SOFTWARERENDERER_H
+
+#include "RenderBackend.h"
+#include "JobSystem.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// draws a RenderCommandList into an RGBA8 image on the CPU, no GPU or window needed. every command
+// is turned into a screen space primitive (through the camera for world ones) and binned into the
+// 64x64 tiles it touches, then the tiles are rasterized in parallel on the job system, each tile by
+// one thread in command order, so the image is the same whatever the thread count. rects, circles
+// and sprites (nearest texel from the atlas pages, times the tint) are alpha blended source-over.
+// text isn't drawn, there is no font without raylib; it is counted instead
+class SoftwareRenderer : public RenderBackend {
+public:
+	// threadCount as for JobSystem, 0 = all cores
+	SoftwareRenderer(int width, int height, unsigned int threadCount = 0);
+
+	void SetClearColor(Color color) { clearColor = color; }
+
+	virtual void Submit(const RenderCommandList& commands) override;
+
+	int GetWidth() const { return width; }
+	int GetHeight() const { return height; }
+	const Color* GetPixels() const { return pixels.data(); }
+	unsigned int GetThreadCount() const { return jobs.GetThreadCount(); }
+
+	// of the last Submit: primitives that landed on screen, text commands left out
+	size_t GetPrimitiveCount() const { return primitives.size(); }
+	size_t GetSkippedTextCount() const { return skippedText; }
+
+	static constexpr int kTileSize = 64;
+
+private:
+	struct Primitive {
+		uint8_t type;            // RenderCommand::Rect / Circle / Sprite
+		Color color;
+		float x0, y0, x1, y1;    // screen bounds
+		float radius;            // Circle, centered in the bounds
+		const SpriteImage* page; // Sprite, nullptr draws it as a solid rect of its tint
+		Rectangle source;        // Sprite, in page pixels
+	};
+
+	void AddPrimitive(const RenderCommand& command, const Camera2D* camera);
+	void RasterTile(size_t tile);
+
+	int width;
+	int height;
+	int tilesX;
+	int tilesY;
+	Color clearColor;
+	std::vector<Color> pixels;
+	std::vector<Primitive> primitives;
+	std::vector<std::vector<uint32_t>> tileBins; // primitive indices per tile, in command order
+	size_t skippedText;
+	JobSystem jobs;
+};
+
+#endif // SOFTWARERENDERER_H
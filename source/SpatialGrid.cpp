@@ -0,0 +1,90 @@
+#include "SpatialGrid.h"
+
+SpatialGrid::SpatialGrid(float cellSize, size_t bucketCount)
+	: cellSize(cellSize)
+	, inverseCellSize(1.0f / cellSize)
+	, itemCount(0)
+{
+	// round the bucket count up to a power of two so the hash is a mask
+	size_t count = 1;
+	while (count < bucketCount) count <<= 1;
+
+	bucketMask = static_cast<uint32_t>(count - 1);
+	buckets.resize(count);
+}
+
+void SpatialGrid::Insert(uint32_t id, Vector2 position, uint32_t tag)
+{
+	if (id >= items.size())
+	{
+		items.resize(id + 1, { 0, 0, 0, kNone, 0 });
+	}
+
+	Item& item = items[id];
+	if (item.bucket != kNone) RemoveFromBucket(item);
+	else ++itemCount;
+
+	item.cellX = CellCoord(position.x);
+	item.cellY = CellCoord(position.y);
+	item.tag = tag;
+	AddToBucket(id, item, position);
+}
+
+void SpatialGrid::Move(uint32_t id, Vector2 position)
+{
+	Item& item = items[id];
+
+	int32_t cellX = CellCoord(position.x);
+	int32_t cellY = CellCoord(position.y);
+	if (cellX == item.cellX && cellY == item.cellY)
+	{
+		Entry& entry = EntryOf(item);
+		entry.x = position.x;
+		entry.y = position.y;
+		return;
+	}
+
+	RemoveFromBucket(item);
+	item.cellX = cellX;
+	item.cellY = cellY;
+	AddToBucket(id, item, position);
+}
+
+void SpatialGrid::Remove(uint32_t id)
+{
+	if (!Contains(id)) return;
+
+	RemoveFromBucket(items[id]);
+	items[id].bucket = kNone;
+	--itemCount;
+}
+
+void SpatialGrid::Clear()
+{
+	for (std::vector<Entry>& bucket : buckets)
+	{
+		bucket.clear();
+	}
+	items.clear();
+	itemCount = 0;
+}
+
+void SpatialGrid::AddToBucket(uint32_t id, Item& item, Vector2 position)
+{
+	item.bucket = BucketFor(item.cellX, item.cellY);
+
+	std::vector<Entry>& bucket = buckets[item.bucket];
+	item.slotInBucket = static_cast<uint32_t>(bucket.size());
+	bucket.push_back({ id, position.x, position.y, item.cellX, item.cellY });
+}
+
+void SpatialGrid::RemoveFromBucket(Item& item)
+{
+	std::vector<Entry>& bucket = buckets[item.bucket];
+
+	// swap-and-pop, fix up whoever got moved into the hole
+	const Entry& moved = bucket.back();
+	items[moved.id].slotInBucket = item.slotInBucket;
+	bucket[item.slotInBucket] = moved;
+	bucket.pop_back();
+}
@@ -0,0 +1,153 @@
+#pragma once
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "raylib.h"
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// uniform grid hashed into a fixed bucket table, so the world can be any size (800x600 or far bigger)
+// without allocating empty cells. items are small integer ids (actor / enemy slots) and are kept
+// up to date incrementally: Move only touches buckets when an item crosses into another cell,
+// which for anything slower than cellSize per frame is rare. Insert/Move/Remove are O(1).
+class SpatialGrid {
+public:
+	explicit SpatialGrid(float cellSize = 32.0f, size_t bucketCount = 4096);
+
+	void Insert(uint32_t id, Vector2 position, uint32_t tag = 0);
+	void Move(uint32_t id, Vector2 position);
+	void Remove(uint32_t id);
+	void Clear();
+
+	bool Contains(uint32_t id) const { return id < items.size() && items[id].bucket != kNone; }
+	Vector2 GetPosition(uint32_t id) const { const Entry& e = EntryOf(items[id]); return { e.x, e.y }; }
+	uint32_t GetTag(uint32_t id) const { return items[id].tag; }
+	size_t Size() const { return itemCount; }
+	float GetCellSize() const { return cellSize; }
+
+	// visit(id, position) for every item inside the circle / rectangle.
+	// visit may return false to stop the query early (handy for "first N neighbours").
+	// maxCandidates bounds how many items are looked at in total (the cell under center goes first),
+	// which keeps per-query cost flat when thousands of things pile up in the same few cells
+	template<typename Visitor>
+	void QueryRadius(Vector2 center, float radius, Visitor&& visit, size_t maxCandidates = SIZE_MAX) const
+	{
+		const float radiusSq = radius * radius;
+		size_t candidates = 0;
+		Query(center.x - radius, center.y - radius, center.x + radius, center.y + radius, CellCoord(center.x), CellCoord(center.y),
+			[&](const Entry& entry) {
+				if (++candidates > maxCandidates) return false;
+				float dx = entry.x - center.x;
+				float dy = entry.y - center.y;
+				if (dx * dx + dy * dy > radiusSq) return true;
+				return Invoke(visit, entry.id, Vector2{ entry.x, entry.y });
+			});
+	}
+
+	template<typename Visitor>
+	void QueryRect(Rectangle rect, Visitor&& visit) const
+	{
+		const float maxX = rect.x + rect.width;
+		const float maxY = rect.y + rect.height;
+		Query(rect.x, rect.y, maxX, maxY, CellCoord(rect.x), CellCoord(rect.y),
+			[&](const Entry& entry) {
+				if (entry.x < rect.x || entry.x > maxX || entry.y < rect.y || entry.y > maxY) return true;
+				return Invoke(visit, entry.id, Vector2{ entry.x, entry.y });
+			});
+	}
+
+private:
+	static const uint32_t kNone = 0xffffffffu;
+
+	// what queries scan: stored inline in the bucket so a query walks memory linearly
+	// instead of jumping to items[id] for every candidate
+	struct Entry {
+		uint32_t id;
+		float x;
+		float y;
+		int32_t cellX;
+		int32_t cellY;
+	};
+
+	// per id bookkeeping, only touched on insert/move/remove
+	struct Item {
+		int32_t cellX;
+		int32_t cellY;
+		uint32_t tag;
+		uint32_t bucket;       // kNone when not in the grid
+		uint32_t slotInBucket; // index into buckets[bucket], for swap-and-pop removal
+	};
+
+	const Entry& EntryOf(const Item& item) const { return buckets[item.bucket][item.slotInBucket]; }
+	Entry& EntryOf(const Item& item) { return buckets[item.bucket][item.slotInBucket]; }
+
+	int32_t CellCoord(float v) const { return static_cast<int32_t>(std::floor(v * inverseCellSize)); }
+
+	uint32_t BucketFor(int32_t cellX, int32_t cellY) const
+	{
+		uint32_t h = static_cast<uint32_t>(cellX) * 73856093u ^ static_cast<uint32_t>(cellY) * 19349663u;
+		return h & bucketMask;
+	}
+
+	void AddToBucket(uint32_t id, Item& item, Vector2 position);
+	void RemoveFromBucket(Item& item);
+
+	// visitors may return void (always continue) or bool
+	template<typename Visitor>
+	static bool Invoke(Visitor& visit, uint32_t id, Vector2 position)
+	{
+		if constexpr (std::is_void<decltype(visit(id, position))>::value)
+		{
+			visit(id, position);
+			return true;
+		}
+		else
+		{
+			return visit(id, position);
+		}
+	}
+
+	// visits the first cell, then every other cell overlapping the box
+	template<typename Visitor>
+	void Query(float minX, float minY, float maxX, float maxY, int32_t firstX, int32_t firstY, Visitor&& visit) const
+	{
+		const int32_t x0 = CellCoord(minX), x1 = CellCoord(maxX);
+		const int32_t y0 = CellCoord(minY), y1 = CellCoord(maxY);
+
+		if (!QueryCell(firstX, firstY, visit)) return;
+
+		for (int32_t cy = y0; cy <= y1; ++cy)
+		{
+			for (int32_t cx = x0; cx <= x1; ++cx)
+			{
+				if (cx == firstX && cy == firstY) continue;
+				if (!QueryCell(cx, cy, visit)) return;
+			}
+		}
+	}
+
+	template<typename Visitor>
+	bool QueryCell(int32_t cx, int32_t cy, Visitor& visit) const
+	{
+		// several cells share a bucket, only look at items that really are in this cell
+		const std::vector<Entry>& bucket = buckets[BucketFor(cx, cy)];
+		for (const Entry& entry : bucket)
+		{
+			if (entry.cellX != cx || entry.cellY != cy) continue;
+			if (!visit(entry)) return false;
+		}
+		return true;
+	}
+
+	float cellSize;
+	float inverseCellSize;
+	uint32_t bucketMask;
+	size_t itemCount;
+	std::vector<Item> items;                   // indexed by id
+	std::vector<std::vector<Entry>> buckets;
+};
+
+#endif // SPATIALGRID_H
@@ -0,0 +1,96 @@
+#include "Benchmarks.h"
+#include "GameMode.h"
+#include "Player.h"
+#include "Enemy.h"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace {
+
+	const int kWaveSize = 10000;
+	const int kWaves = 20;
+
+} // namespace
+
+int RunSpawnBenchmark()
+{
+	std::printf("spawn benchmark: %d waves of %d Enemy actors, level reloaded between waves\n", kWaves, kWaveSize);
+
+	// old path: one make_unique per spawn and one delete per actor on level load
+	double heapSpawn = 0, heapFree = 0;
+	{
+		Player player;
+		std::vector<std::unique_ptr<Actor>> actors;
+
+		for (int wave = 0; wave < kWaves; ++wave)
+		{
+			double start = Profiler::NowMs();
+			for (int i = 0; i < kWaveSize; ++i)
+			{
+				auto enemy = std::make_unique<Enemy>();
+				enemy->BeginPlay();
+				enemy->SetTarget(&player);
+				actors.push_back(std::move(enemy));
+			}
+			double mid = Profiler::NowMs();
+			actors.clear();
+			double end = Profiler::NowMs();
+
+			heapSpawn += mid - start;
+			heapFree += end - mid;
+		}
+	}
+
+	// pooled path, first wave warms the arena up so it is reported separately
+	double poolSpawn = 0, poolFree = 0, firstWave = 0;
+	{
+		GameMode gameMode;
+		gameMode.ReserveActors(kWaveSize + 1);
+
+		for (int wave = 0; wave < kWaves; ++wave)
+		{
+			double start = Profiler::NowMs();
+			Player* player = gameMode.SpawnActor<Player>({ 400, 300 });
+			for (int i = 0; i < kWaveSize; ++i)
+			{
+				gameMode.SpawnActor<Enemy>({ 0, 0 })->SetTarget(player);
+			}
+			double mid = Profiler::NowMs();
+			gameMode.LoadLevel("next");
+			double end = Profiler::NowMs();
+
+			if (wave == 0) firstWave = mid - start;
+			else poolSpawn += mid - start;
+			poolFree += end - mid;
+		}
+
+		std::printf("arena reserved: %zu KB\n", gameMode.GetLevelArena().GetBytesReserved() / 1024);
+	}
+
+	// whole wave through SpawnActors, same warm-up
+	double bulkSpawn = 0, bulkFirstWave = 0;
+	{
+		GameMode gameMode;
+
+		for (int wave = 0; wave < kWaves; ++wave)
+		{
+			double start = Profiler::NowMs();
+			Player* player = gameMode.SpawnActor<Player>({ 400, 300 });
+			gameMode.SpawnActors<Enemy>(kWaveSize, [player](Enemy& enemy, size_t) { enemy.SetTarget(player); });
+			double mid = Profiler::NowMs();
+			gameMode.LoadLevel("next");
+
+			if (wave == 0) bulkFirstWave = mid - start;
+			else bulkSpawn += mid - start;
+		}
+	}
+
+	std::printf("heap:  spawn %.3f ms/wave, free %.3f ms/wave\n", heapSpawn / kWaves, heapFree / kWaves);
+	std::printf("pool:  spawn %.3f ms/wave (first wave %.3f ms), free %.3f ms/wave\n",
+		poolSpawn / (kWaves - 1), firstWave, poolFree / kWaves);
+	std::printf("bulk:  spawn %.3f ms/wave (first wave %.3f ms) through SpawnActors\n", bulkSpawn / (kWaves - 1), bulkFirstWave);
+
+	return 0;
+}
@@ -0,0 +1,211 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <climits>
+
+AtlasPacker::AtlasPacker(int pageWidth, int pageHeight, int padding)
+	: pageWidth(pageWidth)
+	, pageHeight(pageHeight)
+	, padding(padding)
+{ }
+
+int AtlasPacker::FitAt(const std::vector<SkylineNode>& skyline, size_t index, int width, int height) const
+{
+	// the padding of the last column / row may hang over the page edge
+	if (skyline[index].x + width > pageWidth + padding) return -1;
+
+	int y = 0;
+	int widthLeft = width;
+	for (size_t i = index; widthLeft > 0; ++i)
+	{
+		y = std::max(y, skyline[i].y);
+		if (y + height > pageHeight + padding) return -1;
+		widthLeft -= skyline[i].width;
+	}
+	return y;
+}
+
+void AtlasPacker::Place(std::vector<SkylineNode>& skyline, size_t index, int x, int y, int width, int height)
+{
+	skyline.insert(skyline.begin() + index, SkylineNode{ x, y + height, width });
+
+	// the nodes the new one covers get cut down or dropped
+	for (size_t i = index + 1; i < skyline.size();)
+	{
+		const SkylineNode& previous = skyline[i - 1];
+		int overlap = previous.x + previous.width - skyline[i].x;
+		if (overlap <= 0) break;
+
+		skyline[i].x += overlap;
+		skyline[i].width -= overlap;
+		if (skyline[i].width > 0) break;
+		skyline.erase(skyline.begin() + i);
+	}
+
+	// neighbours at the same height become one
+	for (size_t i = 0; i + 1 < skyline.size();)
+	{
+		if (skyline[i].y == skyline[i + 1].y)
+		{
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+void AtlasPacker::Pack(const std::vector<PackSize>& sizes, std::vector<PackedRect>& out)
+{
+	out.assign(sizes.size(), PackedRect{ -1, 0, 0 });
+
+	std::vector<size_t> order(sizes.size());
+	for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+	std::sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) {
+		if (sizes[a].height != sizes[b].height) return sizes[a].height > sizes[b].height;
+		if (sizes[a].width != sizes[b].width) return sizes[a].width > sizes[b].width;
+		return a < b;
+	});
+
+	for (size_t i : order)
+	{
+		const int width = sizes[i].width + padding;
+		const int height = sizes[i].height + padding;
+		if (width > pageWidth + padding || height > pageHeight + padding) continue;
+
+		for (size_t page = 0; ; ++page)
+		{
+			if (page == pages.size()) pages.push_back({ SkylineNode{ 0, 0, pageWidth + padding } });
+			std::vector<SkylineNode>& skyline = pages[page];
+
+			// bottom-left: lowest top edge wins, the leftmost of those
+			int bestY = INT_MAX;
+			size_t bestNode = 0;
+			for (size_t node = 0; node < skyline.size(); ++node)
+			{
+				int y = FitAt(skyline, node, width, height);
+				if (y >= 0 && y < bestY)
+				{
+					bestY = y;
+					bestNode = node;
+				}
+			}
+
+			if (bestY == INT_MAX) continue;
+
+			out[i] = { static_cast<int>(page), skyline[bestNode].x, bestY };
+			Place(skyline, bestNode, skyline[bestNode].x, bestY, width, height);
+			break;
+		}
+	}
+}
+
+TextureAtlas::TextureAtlas(int pageSize)
+	: pageSize(pageSize)
+	, built(false)
+	, whiteUv{ 0, 0 }
+{ }
+
+SpriteId TextureAtlas::Add(const std::string& name, SpriteImage image)
+{
+	Sprite sprite;
+	sprite.name = name;
+	sprite.image = std::move(image);
+	sprite.region = {};
+	sprites.push_back(std::move(sprite));
+	return static_cast<SpriteId>(sprites.size() - 1);
+}
+
+SpriteId TextureAtlas::Find(const std::string& name) const
+{
+	for (size_t i = 0; i < sprites.size(); ++i)
+	{
+		if (sprites[i].name == name) return static_cast<SpriteId>(i);
+	}
+	return kNoSprite;
+}
+
+bool TextureAtlas::Build()
+{
+	// every image gets a 1px border copied from its edges, so filtering at the region's edge never
+	// picks up the neighbour
+	const int kBorder = 1;
+	const int kWhiteSize = 4;
+
+	AtlasPacker packer(pageSize, pageSize);
+	std::vector<PackedRect> placed;
+
+	// the white block goes first so it is on page 0 whatever else there is
+	packer.Pack({ PackSize{ kWhiteSize, kWhiteSize } }, placed);
+	const PackedRect white = placed[0];
+
+	std::vector<PackSize> sizes(sprites.size());
+	for (size_t i = 0; i < sprites.size(); ++i)
+	{
+		sizes[i] = { sprites[i].image.width + kBorder * 2, sprites[i].image.height + kBorder * 2 };
+	}
+	packer.Pack(sizes, placed);
+
+	pages.assign(packer.GetPageCount(), SpriteImage(pageSize, pageSize));
+	for (int y = 0; y < kWhiteSize; ++y)
+	{
+		for (int x = 0; x < kWhiteSize; ++x) pages[0].At(white.x + x, white.y + y) = WHITE;
+	}
+	whiteUv = { (white.x + kWhiteSize * 0.5f) / pageSize, (white.y + kWhiteSize * 0.5f) / pageSize };
+
+	bool allFit = true;
+	for (size_t i = 0; i < sprites.size(); ++i)
+	{
+		Sprite& sprite = sprites[i];
+		const PackedRect& rect = placed[i];
+		if (rect.page < 0)
+		{
+			allFit = false;
+			continue;
+		}
+
+		// image plus border, edge pixels clamped into the border
+		SpriteImage& page = pages[rect.page];
+		const SpriteImage& image = sprite.image;
+		for (int y = -kBorder; y < image.height + kBorder; ++y)
+		{
+			int sourceY = std::min(std::max(y, 0), image.height - 1);
+			for (int x = -kBorder; x < image.width + kBorder; ++x)
+			{
+				int sourceX = std::min(std::max(x, 0), image.width - 1);
+				page.At(rect.x + kBorder + x, rect.y + kBorder + y) = image.At(sourceX, sourceY);
+			}
+		}
+
+		const float left = static_cast<float>(rect.x + kBorder);
+		const float top = static_cast<float>(rect.y + kBorder);
+		sprite.region.page = rect.page;
+		sprite.region.source = { left, top, static_cast<float>(image.width), static_cast<float>(image.height) };
+		sprite.region.u0 = left / pageSize;
+		sprite.region.v0 = top / pageSize;
+		sprite.region.u1 = (left + image.width) / pageSize;
+		sprite.region.v1 = (top + image.height) / pageSize;
+
+		sprite.image = SpriteImage(); // the page has it now
+	}
+
+	built = true;
+	return allFit;
+}
+
+void TextureAtlas::Upload()
+{
+	Unload();
+	for (SpriteImage& page : pages)
+	{
+		Image image = { page.pixels.data(), page.width, page.height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+		textures.push_back(LoadTextureFromImage(image));
+	}
+}
+
+void TextureAtlas::Unload()
+{
+	for (Texture2D& texture : textures) UnloadTexture(texture);
+	textures.clear();
+}
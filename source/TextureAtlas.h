@@ -0,0 +1,128 @@
+#pragma once
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// index of a region in a TextureAtlas, in the order the images were added
+typedef uint32_t SpriteId;
+const SpriteId kNoSprite = UINT32_MAX;
+
+// RGBA8 pixels on the CPU, what gets packed
+struct SpriteImage {
+	int width = 0;
+	int height = 0;
+	std::vector<Color> pixels; // row major, width * height
+
+	SpriteImage() {}
+	SpriteImage(int width, int height, Color fill = BLANK) : width(width), height(height), pixels(static_cast<size_t>(width) * height, fill) {}
+
+	Color& At(int x, int y) { return pixels[static_cast<size_t>(y) * width + x]; }
+	const Color& At(int x, int y) const { return pixels[static_cast<size_t>(y) * width + x]; }
+};
+
+struct PackSize {
+	int width;
+	int height;
+};
+
+// where a rect ended up: page and top left, -1 page when it is bigger than a page
+struct PackedRect {
+	int page;
+	int x;
+	int y;
+};
+
+// skyline bottom-left rect packer. rects go in tallest first (then widest, then input order), each
+// to the lowest, then leftmost, spot the skyline of its page has room for, a new page when none of
+// them has. the same sizes always give the same layout. padding is left free right of and below
+// every rect. Pack calls add to the pages the earlier ones filled
+class AtlasPacker {
+public:
+	AtlasPacker(int pageWidth, int pageHeight, int padding = 0);
+
+	// out[i] is where sizes[i] went
+	void Pack(const std::vector<PackSize>& sizes, std::vector<PackedRect>& out);
+	int GetPageCount() const { return static_cast<int>(pages.size()); }
+	void Reset() { pages.clear(); }
+
+private:
+	struct SkylineNode {
+		int x;
+		int y;
+		int width;
+	};
+
+	// lowest y rect width x height can sit at with its left edge on node index, -1 if it doesn't fit
+	int FitAt(const std::vector<SkylineNode>& skyline, size_t index, int width, int height) const;
+	void Place(std::vector<SkylineNode>& skyline, size_t index, int x, int y, int width, int height);
+
+	int pageWidth;
+	int pageHeight;
+	int padding;
+	std::vector<std::vector<SkylineNode>> pages; // one skyline per page
+};
+
+// every sprite of the game packed into as few pages as possible (one with the built in sprites), so
+// the whole frame draws from one texture and rlgl never splits its batch on a texture change.
+// images are added by name, Build packs them and composites the pages, Upload makes GL textures
+// (main thread, after InitWindow). page 0 also holds a white texel that solid shapes are drawn with
+class TextureAtlas {
+public:
+	struct Region {
+		int page;
+		Rectangle source; // in page pixels
+		float u0, v0;     // texture coordinates of source
+		float u1, v1;
+	};
+
+	explicit TextureAtlas(int pageSize = 1024);
+
+	TextureAtlas(const TextureAtlas&) = delete;
+	TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+	// before Build. ids count up from 0 in add order, names are for lookups by tools
+	SpriteId Add(const std::string& name, SpriteImage image);
+	// packs everything added and composites the pages, once. false if an image is bigger than a page
+	bool Build();
+	bool IsBuilt() const { return built; }
+
+	// GL textures for the pages, needs the window. safe to skip (headless), backends then get id 0.
+	// nothing unloads by itself, call Unload before CloseWindow
+	void Upload();
+	void Unload();
+	unsigned int GetTextureId(int page) const { return page < static_cast<int>(textures.size()) ? textures[page].id : 0; }
+
+	size_t GetSpriteCount() const { return sprites.size(); }
+	// kNoSprite when there is none by that name
+	SpriteId Find(const std::string& name) const;
+	const Region& GetRegion(SpriteId sprite) const { return sprites[sprite].region; }
+	const std::string& GetName(SpriteId sprite) const { return sprites[sprite].name; }
+
+	int GetPageCount() const { return static_cast<int>(pages.size()); }
+	int GetPageSize() const { return pageSize; }
+	const SpriteImage& GetPage(int page) const { return pages[page]; }
+
+	// texture coordinates of the white texel on page 0
+	Vector2 GetWhiteUv() const { return whiteUv; }
+
+private:
+	struct Sprite {
+		std::string name;
+		SpriteImage image; // dropped once composited
+		Region region;
+	};
+
+	int pageSize;
+	bool built;
+	std::vector<Sprite> sprites;
+	std::vector<SpriteImage> pages;
+	std::vector<Texture2D> textures;
+	Vector2 whiteUv;
+};
+
+#endif // TEXTUREATLAS_H
@@ -0,0 +1,72 @@
+#include "Benchmarks.h"
+#include "GameMode.h"
+#include "Player.h"
+#include "Enemy.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+	const int kSwarmEnemies = 1000000;
+	const int kActorEnemies = 20000;
+	const int kTicks = 60;
+
+	double MeasureMsPerTick(unsigned int threadCount)
+	{
+		GameMode gameMode;
+		gameMode.SetThreadCount(threadCount);
+		gameMode.SetWorldSeed(1234); // same spawn positions for every thread count
+
+		Player* player = gameMode.SpawnActor<Player>({ 400, 300 });
+
+		for (int i = 0; i < kActorEnemies; ++i)
+		{
+			gameMode.SpawnActor<Enemy>({ 0, 0 })->SetTarget(player);
+		}
+
+		gameMode.GetEnemySwarm().Reserve(kSwarmEnemies);
+		for (int i = 0; i < kSwarmEnemies; ++i)
+		{
+			gameMode.SpawnEnemy().SetTarget(player);
+		}
+
+		const float deltaTime = 1.0f / 60.0f;
+		gameMode.Update(deltaTime); // warm up, lets the workers spin up
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < kTicks; ++i)
+		{
+			gameMode.Update(deltaTime);
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count() / kTicks;
+	}
+
+} // namespace
+
+int RunThreadScalingBenchmark()
+{
+	unsigned int maxThreads = std::thread::hardware_concurrency();
+	if (maxThreads == 0) maxThreads = 1;
+
+	std::printf("GameMode::Update scaling: %d swarm enemies + %d Enemy actors, %d ticks\n", kSwarmEnemies, kActorEnemies, kTicks);
+
+	std::vector<unsigned int> counts;
+	for (unsigned int n = 1; n < maxThreads; n *= 2) counts.push_back(n);
+	counts.push_back(maxThreads);
+
+	double baseline = 0;
+	for (unsigned int threads : counts)
+	{
+		double ms = MeasureMsPerTick(threads);
+		if (threads == 1) baseline = ms;
+
+		std::printf("%3u threads  %8.3f ms/tick  %5.2fx\n", threads, ms, baseline / ms);
+	}
+
+	return 0;
+}
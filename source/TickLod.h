@@ -0,0 +1,36 @@
+#pragma once
+#ifndef TICKLOD_H
+#define TICKLOD_H
+
+#include "raylib.h"
+#include <cstdint>
+
+// tick rate by distance to a focus point (the player): every tick up close, every 2nd tick past
+// every2ndBeyond, every 8th past every8thBeyond. whoever is skipped banks the dt and gets it all on
+// its next tick, so movement covers the same distance. the tick an agent lands on is staggered by
+// its id, so each far bucket is spread evenly over the ticks instead of all firing together
+struct TickLod {
+	bool enabled = false;
+	Vector2 focus = { 0, 0 };
+	float every2ndBeyond = 400.0f;
+	float every8thBeyond = 800.0f;
+	uint64_t tick = 0;
+
+	uint32_t GetInterval(Vector2 position) const
+	{
+		float dx = position.x - focus.x;
+		float dy = position.y - focus.y;
+		float distanceSquared = dx * dx + dy * dy;
+		if (distanceSquared > every8thBeyond * every8thBeyond) return 8;
+		if (distanceSquared > every2ndBeyond * every2ndBeyond) return 2;
+		return 1;
+	}
+
+	// intervals are powers of two
+	bool IsDue(uint32_t id, uint32_t interval) const
+	{
+		return ((tick + id) & (interval - 1)) == 0;
+	}
+};
+
+#endif // TICKLOD_H
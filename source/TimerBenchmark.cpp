@@ -0,0 +1,99 @@
+#include "Benchmarks.h"
+#include "TimerManager.h"
+#include "Random.h"
+#include "Profiler.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+	const int kCooldowns = 50000;
+	const int kTicks = 600;
+	const float kDeltaTime = 1.0f / 60.0f;
+
+	// what a cooldown polled in Tick looks like: a float inside each enemy, checked every tick
+	struct PolledEnemy {
+		float cooldown;
+		float interval;
+		unsigned char rest[56]; // the rest of the enemy, so the loop walks memory like a Tick would
+	};
+
+} // namespace
+
+int RunTimerBenchmark()
+{
+	std::printf("timer benchmark: %d repeating enemy cooldowns of 0.5-3 s, %d ticks, 1%% re-armed every tick\n", kCooldowns, kTicks);
+
+	Rng rng(1, kRngStreamScenario);
+	std::vector<int> intervalTicks(kCooldowns);
+	rng.FillRangeInt(intervalTicks.data(), kCooldowns, 30, 180);
+	const int rearmPerTick = kCooldowns / 100;
+
+	// polled: every enemy counts its own cooldown down every tick
+	size_t polledFires = 0;
+	double polledMs = 0;
+	{
+		std::vector<PolledEnemy> enemies(kCooldowns);
+		for (int i = 0; i < kCooldowns; ++i)
+		{
+			enemies[i].interval = intervalTicks[i] * kDeltaTime;
+			enemies[i].cooldown = enemies[i].interval;
+		}
+
+		Rng pick(2, kRngStreamScenario);
+		double start = Profiler::NowMs();
+		for (int t = 0; t < kTicks; ++t)
+		{
+			for (int r = 0; r < rearmPerTick; ++r)
+			{
+				PolledEnemy& enemy = enemies[pick.RangeInt(0, kCooldowns - 1)];
+				enemy.cooldown = enemy.interval;
+			}
+
+			for (PolledEnemy& enemy : enemies)
+			{
+				enemy.cooldown -= kDeltaTime;
+				if (enemy.cooldown <= 0)
+				{
+					enemy.cooldown += enemy.interval;
+					++polledFires;
+				}
+			}
+		}
+		polledMs = Profiler::NowMs() - start;
+	}
+
+	// timing wheel: only the cooldowns that come due are touched, re-arming is a clear + set
+	size_t wheelFires = 0;
+	double wheelMs = 0;
+	{
+		TimerManager timers;
+		std::vector<TimerHandle> handles(kCooldowns);
+		for (int i = 0; i < kCooldowns; ++i)
+		{
+			handles[i] = timers.Set([&wheelFires] { ++wheelFires; }, intervalTicks[i], intervalTicks[i]);
+		}
+
+		Rng pick(2, kRngStreamScenario);
+		double start = Profiler::NowMs();
+		for (int t = 0; t < kTicks; ++t)
+		{
+			for (int r = 0; r < rearmPerTick; ++r)
+			{
+				int i = pick.RangeInt(0, kCooldowns - 1);
+				timers.Clear(handles[i]);
+				handles[i] = timers.Set([&wheelFires] { ++wheelFires; }, intervalTicks[i], intervalTicks[i]);
+			}
+
+			timers.Tick();
+		}
+		wheelMs = Profiler::NowMs() - start;
+	}
+
+	std::printf("%-16s %10s %12s\n", "", "ms/tick", "fires");
+	std::printf("%-16s %10.4f %12zu\n", "polled in Tick", polledMs / kTicks, polledFires);
+	std::printf("%-16s %10.4f %12zu\n", "timing wheel", wheelMs / kTicks, wheelFires);
+	std::printf("speedup: %.2fx\n", polledMs / wheelMs);
+	return 0;
+}
@@ -0,0 +1,171 @@
+#include "TimerManager.h"
+#include <utility>
+
+TimerManager::TimerManager()
+	: now(0)
+	, activeCount(0)
+	, firedLastTick(0)
+{
+	// every slot head is an empty circular list pointing at itself
+	timers.resize(kWheels * kSlots);
+	for (uint32_t i = 0; i < timers.size(); ++i)
+	{
+		timers[i].prev = i;
+		timers[i].next = i;
+		timers[i].generation = 0;
+		timers[i].active = false;
+	}
+}
+
+uint32_t TimerManager::Allocate()
+{
+	if (!freeTimers.empty())
+	{
+		uint32_t index = freeTimers.back();
+		freeTimers.pop_back();
+		return index;
+	}
+
+	timers.push_back(Timer());
+	timers.back().generation = 1;
+	timers.back().active = false;
+	return static_cast<uint32_t>(timers.size() - 1);
+}
+
+void TimerManager::Release(uint32_t index)
+{
+	Timer& timer = timers[index];
+	timer.callback = nullptr;
+	timer.active = false;
+	if (++timer.generation == 0) timer.generation = 1;
+	freeTimers.push_back(index);
+	--activeCount;
+}
+
+void TimerManager::Link(uint32_t index)
+{
+	Timer& timer = timers[index];
+	uint64_t delta = timer.expireTick - now;
+
+	// the finest wheel whose range covers the delay, slot picked by the expire tick's digit on it
+	int wheel = 0;
+	while (wheel < kWheels - 1 && delta >= (uint64_t(1) << (kSlotBits * (wheel + 1)))) ++wheel;
+
+	uint64_t expire = timer.expireTick;
+	if (wheel == kWheels - 1 && delta >= (uint64_t(1) << (kSlotBits * kWheels)))
+	{
+		// further out than the wheels reach: park it on the last slot, it is re-sorted when that comes round
+		expire = now + (uint64_t(1) << (kSlotBits * kWheels)) - 1;
+	}
+
+	uint32_t head = Head(wheel, static_cast<uint32_t>(expire >> (kSlotBits * wheel)) & (kSlots - 1));
+	timer.prev = timers[head].prev;
+	timer.next = head;
+	timers[timers[head].prev].next = index;
+	timers[head].prev = index;
+}
+
+void TimerManager::Unlink(uint32_t index)
+{
+	Timer& timer = timers[index];
+	timers[timer.prev].next = timer.next;
+	timers[timer.next].prev = timer.prev;
+	timer.prev = index;
+	timer.next = index;
+}
+
+TimerHandle TimerManager::Set(std::function<void()> callback, uint64_t delayTicks, uint64_t intervalTicks)
+{
+	uint32_t index = Allocate();
+	Timer& timer = timers[index];
+	timer.callback = std::move(callback);
+	timer.expireTick = now + (delayTicks > 0 ? delayTicks : 1);
+	timer.intervalTicks = intervalTicks;
+	timer.active = true;
+	++activeCount;
+
+	Link(index);
+	return { index, timer.generation };
+}
+
+bool TimerManager::IsActive(TimerHandle handle) const
+{
+	return handle.index >= kWheels * kSlots && handle.index < timers.size()
+		&& timers[handle.index].generation == handle.generation && timers[handle.index].active;
+}
+
+void TimerManager::Clear(TimerHandle& handle)
+{
+	if (IsActive(handle))
+	{
+		Unlink(handle.index);
+		Release(handle.index);
+	}
+	handle = TimerHandle();
+}
+
+uint64_t TimerManager::GetRemainingTicks(TimerHandle handle) const
+{
+	return IsActive(handle) ? timers[handle.index].expireTick - now : 0;
+}
+
+void TimerManager::Cascade(int wheel)
+{
+	uint32_t head = Head(wheel, static_cast<uint32_t>(now >> (kSlotBits * wheel)) & (kSlots - 1));
+	while (!IsEmpty(head))
+	{
+		uint32_t index = timers[head].next;
+		Unlink(index);
+		Link(index);
+	}
+}
+
+void TimerManager::Tick()
+{
+	++now;
+	firedLastTick = 0;
+
+	// coarse wheels first, whatever comes down lands in finer slots that are handled right after
+	for (int wheel = kWheels - 1; wheel > 0; --wheel)
+	{
+		if ((now & ((uint64_t(1) << (kSlotBits * wheel)) - 1)) == 0) Cascade(wheel);
+	}
+
+	uint32_t head = Head(0, static_cast<uint32_t>(now) & (kSlots - 1));
+	while (!IsEmpty(head))
+	{
+		uint32_t index = timers[head].next;
+		Unlink(index);
+
+		// the callback may set timers (timers can reallocate) or clear this one, so it runs from a local
+		std::function<void()> callback = std::move(timers[index].callback);
+		uint32_t generation = timers[index].generation;
+
+		if (timers[index].intervalTicks > 0)
+		{
+			timers[index].expireTick = now + timers[index].intervalTicks;
+			Link(index);
+		}
+		else
+		{
+			Release(index);
+		}
+
+		++firedLastTick;
+		callback();
+
+		// still the same looping timer: put the callback back for next time
+		if (timers[index].active && timers[index].generation == generation) timers[index].callback = std::move(callback);
+	}
+}
+
+void TimerManager::ClearAll()
+{
+	for (uint32_t index = kWheels * kSlots; index < timers.size(); ++index)
+	{
+		if (!timers[index].active) continue;
+
+		Unlink(index);
+		Release(index);
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+#ifndef TIMERMANAGER_H
+#define TIMERMANAGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// stable reference to a timer, slot index + generation like ActorHandle. goes stale once the timer
+// has fired (one-shot) or been cleared
+struct TimerHandle {
+	uint32_t index = 0;
+	uint32_t generation = 0; // 0 is never handed out
+
+	bool IsSet() const { return generation != 0; }
+};
+
+// delayed and repeating callbacks counted in ticks, on a hierarchical timing wheel: 4 wheels of 256
+// slots, each slot an intrusive list. the first wheel holds the next 256 ticks one slot per tick, every
+// further wheel 256 times coarser; when a wheel comes round, the slot it reaches is spread over the
+// finer wheels. Set/Clear are O(1) and a tick only touches the timers that are due (plus the cascades,
+// each timer is moved at most once per wheel), however many timers are waiting.
+// game thread only, callbacks may set and clear timers (their own too)
+class TimerManager {
+public:
+	TimerManager();
+
+	// fires delayTicks ticks from now (at least 1), then every intervalTicks if that is > 0
+	TimerHandle Set(std::function<void()> callback, uint64_t delayTicks, uint64_t intervalTicks = 0);
+	// no-op for stale handles, resets the handle
+	void Clear(TimerHandle& handle);
+	bool IsActive(TimerHandle handle) const;
+	// ticks until it fires next, 0 when it isn't active
+	uint64_t GetRemainingTicks(TimerHandle handle) const;
+
+	// one tick: runs every callback due now
+	void Tick();
+	uint64_t GetCurrentTick() const { return now; }
+
+	size_t GetActiveCount() const { return activeCount; }
+	size_t GetFiredLastTick() const { return firedLastTick; }
+
+	// drops every timer, handles go stale
+	void ClearAll();
+
+private:
+	static constexpr int kWheels = 4;
+	static constexpr int kSlotBits = 8;
+	static constexpr uint32_t kSlots = 1u << kSlotBits;
+	static constexpr uint32_t kNone = UINT32_MAX;
+
+	struct Timer {
+		std::function<void()> callback;
+		uint64_t expireTick;
+		uint64_t intervalTicks;
+		uint32_t generation;
+		uint32_t prev;     // list links, the first kWheels * kSlots entries are the slot heads
+		uint32_t next;
+		bool active;
+	};
+
+	uint32_t Allocate();
+	void Release(uint32_t index);
+	void Link(uint32_t index);        // into the slot its expire tick belongs to
+	void Unlink(uint32_t index);
+	void Cascade(int wheel);          // spread the wheel's current slot over the finer wheels
+	uint32_t Head(int wheel, uint32_t slot) const { return static_cast<uint32_t>(wheel) * kSlots + slot; }
+	bool IsEmpty(uint32_t head) const { return timers[head].next == head; }
+
+	std::vector<Timer> timers;         // slot heads, then timers
+	std::vector<uint32_t> freeTimers;
+	uint64_t now;
+	size_t activeCount;
+	size_t firedLastTick;
+};
+
+#endif // TIMERMANAGER_H
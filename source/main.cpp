@@ -5,47 +5,141 @@
 #include "raylib.h"
 #include "GameMode.h"
 #include "Player.h"
-#include "Enemy.h"
+#include "DefaultLevel.h"
+#include "InputRecording.h"
+#include "BatchRenderer.h"
+#include "RenderPipeline.h"
+#include "TextureAtlas.h"
+#include "GameSprites.h"
+#include "HudText.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 
-int main()
+// usage: RaylibTemplate [--record path | --replay path] [--sequential]
+int main(int argc, char** argv)
 {
+	const char* recordPath = nullptr; // every tick's input goes here when the window closes
+	const char* replayPath = nullptr; // play a recording back instead of reading the keyboard
+	bool sequential = false;          // simulate and draw one after the other on the main thread
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--sequential") == 0) sequential = true;
+		else if (i + 1 < argc && std::strcmp(argv[i], "--record") == 0) recordPath = argv[++i];
+		else if (i + 1 < argc && std::strcmp(argv[i], "--replay") == 0) replayPath = argv[++i];
+	}
+
+	InputRecording replay;
+	if (replayPath && !replay.Load(replayPath))
+	{
+		std::printf("can't read recording %s\n", replayPath);
+		return 1;
+	}
+
 	InitWindow(800, 600, "My First Game");
-	SetTargetFPS(60);
+	SetTargetFPS(60); // render rate only, 0 = uncapped. the simulation ticks at the game mode's tick rate
 
 	// create dame mode
 
 	GameMode gameMode;
+	gameMode.SetMaxCatchUpSteps(5);
+	if (replayPath)
+	{
+		gameMode.SetTickRate(replay.GetTickRate());
+		gameMode.SetWorldSeed(replay.GetWorldSeed());
+		gameMode.StartReplay(replay);
+	}
+	else
+	{
+		gameMode.SetTickRate(60.0f);
+		gameMode.SetWorldSeed(static_cast<uint64_t>(time(nullptr))); // a different game every run
+	}
+
+	// the level the recording was made on, or the game's own
+	LevelDescription level = replayPath ? replay.GetLevel() : LevelDescription();
+	BuildLevel(gameMode, level);
+	if (recordPath) gameMode.StartRecording(level);
 
-	// spawn player
-	Player* player = gameMode.SpawnActor<Player>({ 400, 300 });
+	Profiler& profiler = gameMode.GetProfiler();
+	size_t renderPhase = profiler.AddPhase("Render");
+	size_t pipelineWaitPhase = profiler.AddPhase("Pipeline Wait");
 
-	// spawn some enemies
+	// frame N+1 simulates and records on the pipeline's thread while the main thread draws frame N
+	BatchRenderer renderer;
+	RenderPipeline pipeline(!sequential);
 
-	for (int i = 0; i < 5; ++i)
+	// every sprite on one texture page, so the frame is drawn without a texture switch
+	TextureAtlas atlas(256);
+	AddGameSprites(atlas);
+	HudFont hudFont;
+	hudFont.AddGlyphs(atlas, GetFontDefault());
+	if (!atlas.Build())
 	{
-		Enemy* enemy = gameMode.SpawnActor<Enemy>({ 0, 0 });
-		enemy->SetTarget(player); // set player as target for enemy
+		// a sprite bigger than a page, it would draw as nothing
+		std::printf("texture atlas: a sprite doesn't fit on a %dpx page\n", atlas.GetPageSize());
+		CloseWindow();
+		return 1;
 	}
+	atlas.Upload();
+	renderer.SetAtlas(&atlas);
+
+	// the HUD is laid out once and again only when a number changes
+	HudText hud(hudFont);
+	HudText::Label fpsLabel = hud.Add("FPS: %i", 10, 10, 20, DARKGRAY);
+	// how many ticks a full AI pass takes, i.e. how stale enemy decisions are
+	HudText::Label aiLagLabel = hud.Add("AI lag: %i ticks", 10, 580, 10, DARKGRAY);
+	// what the camera culling let through this frame (F4 turns it off, +/- zoom)
+	HudText::Label visibleLabel = hud.Add("visible: %i / %i", 10, 566, 10, DARKGRAY);
 
 	// main game loop
 
 	while (!WindowShouldClose())
 	{
+		// nothing is recording between Wait and Kick: raylib's input and timing are read here
 		float deltaTime = GetFrameTime();
-
+		int fps = GetFPS();
 		gameMode.HandleInput();
-		ClearBackground(RAYWHITE); // added this to clear frames 
-		gameMode.Update(deltaTime);
 
-		gameMode.Draw();
+		pipeline.Kick([&gameMode, &profiler, &hud, fpsLabel, aiLagLabel, visibleLabel, deltaTime, fps](RenderCommandList& commands) {
+			gameMode.Advance(deltaTime);
+			gameMode.Draw(commands);
 
-		// draw the FPS
-		DrawText(TextFormat("FPS: &i", GetFPS()), 10, 10, 20, DARKGRAY);
+			const GameMode::CullStats& cull = gameMode.GetCullStats();
+			hud.Set(fpsLabel, fps);
+			hud.Set(aiLagLabel, static_cast<int>(gameMode.GetAIScheduler().GetStats().lastPassTicks));
+			hud.Set(visibleLabel, static_cast<int>(cull.GetVisible()), static_cast<int>(cull.GetTotal()));
+			hud.Draw(commands);
 
+			// F3
+			profiler.DrawOverlay(commands, 10, 40);
+		});
+
+		// --sequential draws the frame it just recorded, the pipeline draws the one before while this one records
+		if (!pipeline.IsThreaded()) pipeline.Wait();
+
+		double renderStart = Profiler::NowMs();
+		BeginDrawing();
+		ClearBackground(RAYWHITE); // added this to clear frames 
+		renderer.Submit(pipeline.GetFront());
 		EndDrawing();
+		double renderMs = Profiler::NowMs() - renderStart;
+
+		if (pipeline.IsThreaded()) pipeline.Wait();
+
+		// the main thread's phases go in once the simulation thread is done with the profiler
+		profiler.Record(renderPhase, renderMs);
+		profiler.Record(pipelineWaitPhase, pipeline.GetLastWaitMs());
+		profiler.EndFrame();
 	}
 
+	atlas.Unload();
 	CloseWindow();
 
+	if (recordPath && !gameMode.GetRecording().Save(recordPath))
+	{
+		std::printf("can't write recording %s\n", recordPath);
+	}
+	if (replayPath) profiler.PrintSummary();
+
 	return 0;
 } 
\ No newline at end of file